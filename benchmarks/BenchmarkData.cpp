@@ -0,0 +1,74 @@
+#include "BenchmarkData.hpp"
+
+namespace Maze::Benchmarks {
+
+    std::string make_records_json(int record_count) {
+        std::string json = "[";
+
+        for (int i = 0; i < record_count; ++i) {
+            if (i > 0)
+                json += ",";
+
+            json += R"({"id":)" + std::to_string(i)
+                + R"(,"user":"user_)" + std::to_string(i * 7919 % 100000)
+                + R"(","path":"/api/v1/items/)" + std::to_string(i % 977)
+                + R"(?expand=true","status":)" + std::to_string(i % 5 == 0 ? 404 : 200)
+                + R"(,"latency":)" + std::to_string(i % 1000) + "." + std::to_string(i % 89)
+                + R"(,"cached":)" + (i % 3 == 0 ? "true" : "false")
+                + R"(,"tags":["alpha","beta","gamma"],"geo":{"lat":46.0)" + std::to_string(i % 10)
+                + R"(,"lon":14.5)" + std::to_string(i % 7) + R"(,"country":"SI"},"note":null})";
+        }
+
+        json += "]";
+        return json;
+    }
+
+    std::string make_wide_object_json(int key_count) {
+        std::string json = "{";
+
+        for (int i = 0; i < key_count; ++i) {
+            if (i > 0)
+                json += ",";
+
+            json += R"("session_)" + std::to_string(i) + R"(":{"user":)" + std::to_string(i) + R"(,"active":true})";
+        }
+
+        json += "}";
+        return json;
+    }
+
+    std::string make_long_strings_json(int count) {
+        std::string json = "[";
+
+        for (int i = 0; i < count; ++i) {
+            if (i > 0)
+                json += ",";
+
+            json += R"({"html":"<div class='item'><a href='/items/)" + std::to_string(i) + "'>Item " + std::to_string(i)
+                + R"(</a><p>Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor.</p></div>","blob":")";
+            for (int j = 0; j < 8; ++j)
+                json += "TWF6ZSBpcyBhIEpTT04gbGlicmFyeSB3aXRoIGVhc3kgdG8gdXNlIEFQSXMu";
+            json += "\"}";
+        }
+
+        json += "]";
+        return json;
+    }
+
+    std::string make_non_ascii_json(int count) {
+        std::string json = "[";
+
+        for (int i = 0; i < count; ++i) {
+            if (i > 0)
+                json += ",";
+
+            json += R"({"город":"Любляна )" + std::to_string(i)
+                + R"( — столица Словении, крупнейший город страны","描述":"卢布尔雅那是斯洛文尼亚的首都和最大城市，位于国家中部。")"
+                + R"(,"mixed":"Maže: čšž ČŠŽ, naïve café, Grüße, 東京 🚀🌍 )" + std::to_string(i % 97) + R"(","ok":true})";
+        }
+
+        json += "]";
+        return json;
+    }
+
+}  // namespace Maze::Benchmarks
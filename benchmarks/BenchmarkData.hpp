@@ -0,0 +1,19 @@
+#pragma once
+
+#include <string>
+
+namespace Maze::Benchmarks {
+
+    // Array of request log like records mixing strings, numbers, flags and nested objects.
+    std::string make_records_json(int record_count);
+
+    // Single object with key_count unique keys, mapped to small objects.
+    std::string make_wide_object_json(int key_count);
+
+    // Array of objects holding long ASCII strings, an HTML fragment and a base64 blob.
+    std::string make_long_strings_json(int count);
+
+    // Array of objects with Cyrillic, CJK, accented Latin and emoji keys and strings.
+    std::string make_non_ascii_json(int count);
+
+}  // namespace Maze::Benchmarks
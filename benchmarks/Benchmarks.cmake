@@ -0,0 +1,15 @@
+#
+# Set source files that need to be built
+#
+set(MAZE_BENCHMARKS_SOURCES
+    BenchmarkData.cpp
+    BinaryFormatBenchmark.cpp
+    ElementAccessBenchmark.cpp
+    ElementBuildBenchmark.cpp
+    JsonParseBenchmark.cpp
+    JsonSerializeBenchmark.cpp
+    NdJsonBenchmark.cpp
+    NumberBenchmark.cpp
+    SnapshotBenchmark.cpp
+    StructuralIndexBenchmark.cpp
+)
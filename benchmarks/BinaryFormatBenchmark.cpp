@@ -0,0 +1,83 @@
+#include <benchmark/benchmark.h>
+#include <Maze/Maze.hpp>
+#include "BenchmarkData.hpp"
+
+// Encodes and decodes the same records document as JSON, MessagePack and CBOR.
+// Payload size is reported as a counter, items are records per second.
+
+static const int record_count = 10000;
+
+static void BinaryFormat_EncodeJson(benchmark::State& state) {
+    const Maze::Element el = Maze::Element::from_json(Maze::Benchmarks::make_records_json(record_count));
+
+    for (auto _ : state) {
+        std::string output = el.to_json(-1);
+        benchmark::DoNotOptimize(output);
+    }
+
+    state.SetItemsProcessed(state.iterations() * record_count);
+    state.counters["payload"] = (double)el.to_json(-1).size();
+}
+BENCHMARK(BinaryFormat_EncodeJson);
+
+static void BinaryFormat_EncodeMsgPack(benchmark::State& state) {
+    const Maze::Element el = Maze::Element::from_json(Maze::Benchmarks::make_records_json(record_count));
+
+    for (auto _ : state) {
+        std::vector<uint8_t> output = el.to_msgpack();
+        benchmark::DoNotOptimize(output);
+    }
+
+    state.SetItemsProcessed(state.iterations() * record_count);
+    state.counters["payload"] = (double)el.to_msgpack().size();
+}
+BENCHMARK(BinaryFormat_EncodeMsgPack);
+
+static void BinaryFormat_EncodeCbor(benchmark::State& state) {
+    const Maze::Element el = Maze::Element::from_json(Maze::Benchmarks::make_records_json(record_count));
+
+    for (auto _ : state) {
+        std::vector<uint8_t> output = el.to_cbor();
+        benchmark::DoNotOptimize(output);
+    }
+
+    state.SetItemsProcessed(state.iterations() * record_count);
+    state.counters["payload"] = (double)el.to_cbor().size();
+}
+BENCHMARK(BinaryFormat_EncodeCbor);
+
+static void BinaryFormat_DecodeJson(benchmark::State& state) {
+    const std::string input = Maze::Benchmarks::make_records_json(record_count);
+
+    for (auto _ : state) {
+        Maze::Element el = Maze::Element::from_json(input);
+        benchmark::DoNotOptimize(el);
+    }
+
+    state.SetItemsProcessed(state.iterations() * record_count);
+}
+BENCHMARK(BinaryFormat_DecodeJson);
+
+static void BinaryFormat_DecodeMsgPack(benchmark::State& state) {
+    const std::vector<uint8_t> input = Maze::Element::from_json(Maze::Benchmarks::make_records_json(record_count)).to_msgpack();
+
+    for (auto _ : state) {
+        Maze::Element el = Maze::Element::from_msgpack(input);
+        benchmark::DoNotOptimize(el);
+    }
+
+    state.SetItemsProcessed(state.iterations() * record_count);
+}
+BENCHMARK(BinaryFormat_DecodeMsgPack);
+
+static void BinaryFormat_DecodeCbor(benchmark::State& state) {
+    const std::vector<uint8_t> input = Maze::Element::from_json(Maze::Benchmarks::make_records_json(record_count)).to_cbor();
+
+    for (auto _ : state) {
+        Maze::Element el = Maze::Element::from_cbor(input);
+        benchmark::DoNotOptimize(el);
+    }
+
+    state.SetItemsProcessed(state.iterations() * record_count);
+}
+BENCHMARK(BinaryFormat_DecodeCbor);
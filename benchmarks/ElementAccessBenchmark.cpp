@@ -0,0 +1,38 @@
+#include <benchmark/benchmark.h>
+#include <Maze/Maze.hpp>
+#include "BenchmarkData.hpp"
+
+static void ElementAccess_ObjectLookup(benchmark::State& state) {
+    const int count = (int)state.range(0);
+    const Maze::Element el = Maze::Element::from_json(Maze::Benchmarks::make_wide_object_json(count));
+
+    std::vector<std::string> keys;
+    for (int i = 0; i < count; i += std::max(1, count / 64)) {
+        keys.push_back("session_" + std::to_string(i));
+    }
+
+    for (auto _ : state) {
+        for (const auto& key : keys) {
+            benchmark::DoNotOptimize(el.get(key));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * keys.size());
+}
+BENCHMARK(ElementAccess_ObjectLookup)->Arg(8)->Arg(64)->Arg(10000);
+
+static void ElementAccess_LiteralLookup(benchmark::State& state) {
+    const Maze::Element el = Maze::Element::from_json(R"({
+        "upstream_connection_timeout": 30,
+        "upstream_keepalive_requests": 1000,
+        "downstream_read_buffer_size": 65536
+    })");
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(el["upstream_connection_timeout"]);
+        benchmark::DoNotOptimize(el["downstream_read_buffer_size"]);
+    }
+
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+BENCHMARK(ElementAccess_LiteralLookup);
@@ -0,0 +1,70 @@
+#include <benchmark/benchmark.h>
+#include <Maze/Maze.hpp>
+
+static void ElementBuild_PushBack(benchmark::State& state) {
+    const int count = (int)state.range(0);
+
+    for (auto _ : state) {
+        Maze::Element el(Maze::Type::Array);
+        for (int i = 0; i < count; ++i) {
+            el.push_back(i);
+        }
+        benchmark::DoNotOptimize(el);
+    }
+
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(ElementBuild_PushBack)->Arg(1000)->Arg(100000);
+
+static void ElementBuild_PushBack_Reserved(benchmark::State& state) {
+    const int count = (int)state.range(0);
+
+    for (auto _ : state) {
+        Maze::Element el(Maze::Type::Array);
+        el.reserve(count);
+        for (int i = 0; i < count; ++i) {
+            el.push_back(i);
+        }
+        benchmark::DoNotOptimize(el);
+    }
+
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(ElementBuild_PushBack_Reserved)->Arg(1000)->Arg(100000);
+
+static void ElementBuild_Set(benchmark::State& state) {
+    const int count = (int)state.range(0);
+
+    for (auto _ : state) {
+        Maze::Element el(Maze::Type::Object);
+        for (int i = 0; i < count; ++i) {
+            el.set("key" + std::to_string(i), i);
+        }
+        benchmark::DoNotOptimize(el);
+    }
+
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(ElementBuild_Set)->Arg(1000)->Arg(10000);
+
+static void ElementBuild_SetMany(benchmark::State& state) {
+    const int count = (int)state.range(0);
+
+    for (auto _ : state) {
+        std::vector<std::string> keys;
+        std::vector<Maze::Element> values;
+        keys.reserve(count);
+        values.reserve(count);
+        for (int i = 0; i < count; ++i) {
+            keys.push_back("key" + std::to_string(i));
+            values.push_back(i);
+        }
+
+        Maze::Element el(Maze::Type::Object);
+        el.set_many(std::move(keys), std::move(values));
+        benchmark::DoNotOptimize(el);
+    }
+
+    state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(ElementBuild_SetMany)->Arg(1000)->Arg(10000);
@@ -0,0 +1,163 @@
+#include <benchmark/benchmark.h>
+#include <Maze/Maze.hpp>
+#include <Maze/Document.hpp>
+#include <Maze/Helpers.hpp>
+#include <Maze/JsonPushParser.hpp>
+#include <Maze/JsonStream.hpp>
+#include <sstream>
+#include "BenchmarkData.hpp"
+
+static void JsonParse_Native(benchmark::State& state) {
+    const std::string input = Maze::Benchmarks::make_records_json((int)state.range(0));
+
+    for (auto _ : state) {
+        Maze::Element el = Maze::Element::from_json(input);
+        benchmark::DoNotOptimize(el);
+    }
+
+    state.SetBytesProcessed(state.iterations() * input.size());
+}
+BENCHMARK(JsonParse_Native)->Arg(100)->Arg(10000);
+
+static void JsonParse_Indented(benchmark::State& state) {
+    const std::string input = Maze::Element::from_json(Maze::Benchmarks::make_records_json((int)state.range(0))).to_json(4);
+
+    for (auto _ : state) {
+        Maze::Element el = Maze::Element::from_json(input);
+        benchmark::DoNotOptimize(el);
+    }
+
+    state.SetBytesProcessed(state.iterations() * input.size());
+}
+BENCHMARK(JsonParse_Indented)->Arg(100)->Arg(10000);
+
+static void JsonParse_Document(benchmark::State& state) {
+    const std::string input = Maze::Benchmarks::make_records_json((int)state.range(0));
+    Maze::Document doc;
+
+    for (auto _ : state) {
+        doc.parse(input);
+        benchmark::DoNotOptimize(doc.root());
+        doc.reset();
+    }
+
+    state.SetBytesProcessed(state.iterations() * input.size());
+}
+BENCHMARK(JsonParse_Document)->Arg(100)->Arg(10000);
+
+static void JsonParse_DocumentLongStrings(benchmark::State& state) {
+    const std::string input = Maze::Benchmarks::make_long_strings_json((int)state.range(0));
+    Maze::Document doc;
+
+    for (auto _ : state) {
+        doc.parse(input);
+        benchmark::DoNotOptimize(doc.root());
+        doc.reset();
+    }
+
+    state.SetBytesProcessed(state.iterations() * input.size());
+}
+BENCHMARK(JsonParse_DocumentLongStrings)->Arg(5000);
+
+static void JsonParse_Stream(benchmark::State& state) {
+    const std::string input = Maze::Benchmarks::make_records_json((int)state.range(0));
+    Maze::JsonStream stream([](Maze::Element&& el) { benchmark::DoNotOptimize(el); });
+
+    for (auto _ : state) {
+        std::istringstream stream_input(input);
+        stream.parse(stream_input);
+    }
+
+    state.SetBytesProcessed(state.iterations() * input.size());
+}
+BENCHMARK(JsonParse_Stream)->Arg(100)->Arg(10000);
+
+static void JsonParse_PushChunks(benchmark::State& state) {
+    const std::string input = Maze::Benchmarks::make_records_json(10000);
+    const size_t chunk_size = (size_t)state.range(0);
+    Maze::JsonPushParser parser;
+
+    for (auto _ : state) {
+        for (size_t i = 0; i < input.size(); i += chunk_size) {
+            parser.feed(std::string_view(input).substr(i, chunk_size));
+        }
+
+        Maze::Element el = parser.finish();
+        benchmark::DoNotOptimize(el);
+    }
+
+    state.SetBytesProcessed(state.iterations() * input.size());
+}
+BENCHMARK(JsonParse_PushChunks)->Arg(1500)->Arg(16 * 1024);
+
+static void JsonParse_ThroughNlohmann(benchmark::State& state) {
+    const std::string input = Maze::Benchmarks::make_records_json((int)state.range(0));
+
+    for (auto _ : state) {
+        Maze::Element el = Maze::Helpers::Element::from_json(nlohmann::json::parse(input));
+        benchmark::DoNotOptimize(el);
+    }
+
+    state.SetBytesProcessed(state.iterations() * input.size());
+}
+BENCHMARK(JsonParse_ThroughNlohmann)->Arg(100)->Arg(10000);
+
+static void JsonParse_WideObject(benchmark::State& state) {
+    const std::string input = Maze::Benchmarks::make_wide_object_json((int)state.range(0));
+
+    for (auto _ : state) {
+        Maze::Element el = Maze::Element::from_json(input);
+        benchmark::DoNotOptimize(el);
+    }
+
+    state.SetBytesProcessed(state.iterations() * input.size());
+}
+BENCHMARK(JsonParse_WideObject)->Arg(1000)->Arg(10000);
+
+static void JsonParse_FewFields(benchmark::State& state) {
+    const std::string input = Maze::Benchmarks::make_wide_object_json((int)state.range(0));
+
+    for (auto _ : state) {
+        Maze::Element el = Maze::Element::from_json(input);
+        benchmark::DoNotOptimize(el["session_0"]["user"].i() + el["session_7"]["user"].i() + el["session_42"]["user"].i());
+    }
+
+    state.SetBytesProcessed(state.iterations() * input.size());
+}
+BENCHMARK(JsonParse_FewFields)->Arg(1000)->Arg(10000);
+
+static void JsonParse_LazyFewFields(benchmark::State& state) {
+    const std::string input = Maze::Benchmarks::make_wide_object_json((int)state.range(0));
+
+    for (auto _ : state) {
+        Maze::Element el = Maze::Element::from_json_lazy(input);
+        benchmark::DoNotOptimize(el["session_0"]["user"].i() + el["session_7"]["user"].i() + el["session_42"]["user"].i());
+    }
+
+    state.SetBytesProcessed(state.iterations() * input.size());
+}
+BENCHMARK(JsonParse_LazyFewFields)->Arg(1000)->Arg(10000);
+
+static void JsonParse_LongStrings(benchmark::State& state) {
+    const std::string input = Maze::Benchmarks::make_long_strings_json((int)state.range(0));
+
+    for (auto _ : state) {
+        Maze::Element el = Maze::Element::from_json(input);
+        benchmark::DoNotOptimize(el);
+    }
+
+    state.SetBytesProcessed(state.iterations() * input.size());
+}
+BENCHMARK(JsonParse_LongStrings)->Arg(5000);
+
+static void JsonParse_NonAscii(benchmark::State& state) {
+    const std::string input = Maze::Benchmarks::make_non_ascii_json((int)state.range(0));
+
+    for (auto _ : state) {
+        Maze::Element el = Maze::Element::from_json(input);
+        benchmark::DoNotOptimize(el);
+    }
+
+    state.SetBytesProcessed(state.iterations() * input.size());
+}
+BENCHMARK(JsonParse_NonAscii)->Arg(5000);
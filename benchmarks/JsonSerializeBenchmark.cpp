@@ -0,0 +1,170 @@
+#include <benchmark/benchmark.h>
+#include <Maze/Maze.hpp>
+#include <Maze/Helpers.hpp>
+#include <Maze/JsonSegments.hpp>
+#include "BenchmarkData.hpp"
+
+static void JsonSerialize_Native(benchmark::State& state) {
+    const Maze::Element el = Maze::Element::from_json(Maze::Benchmarks::make_records_json(10000));
+    const int indentation = (int)state.range(0);
+    size_t bytes = 0;
+
+    for (auto _ : state) {
+        std::string output = el.to_json(indentation);
+        bytes += output.size();
+        benchmark::DoNotOptimize(output);
+    }
+
+    state.SetBytesProcessed(bytes);
+}
+BENCHMARK(JsonSerialize_Native)->Arg(-1)->Arg(2);
+
+static void JsonSerialize_ThroughNlohmann(benchmark::State& state) {
+    const Maze::Element el = Maze::Element::from_json(Maze::Benchmarks::make_records_json(10000));
+    const int indentation = (int)state.range(0);
+    size_t bytes = 0;
+
+    for (auto _ : state) {
+        std::string output = Maze::Helpers::Element::to_json_element(el).dump(indentation);
+        bytes += output.size();
+        benchmark::DoNotOptimize(output);
+    }
+
+    state.SetBytesProcessed(bytes);
+}
+BENCHMARK(JsonSerialize_ThroughNlohmann)->Arg(-1)->Arg(2);
+
+static void JsonSerialize_LongStrings(benchmark::State& state) {
+    const Maze::Element el = Maze::Element::from_json(Maze::Benchmarks::make_long_strings_json((int)state.range(0)));
+    size_t bytes = 0;
+
+    for (auto _ : state) {
+        std::string output = el.to_json(-1);
+        bytes += output.size();
+        benchmark::DoNotOptimize(output);
+    }
+
+    state.SetBytesProcessed(bytes);
+}
+BENCHMARK(JsonSerialize_LongStrings)->Arg(5000);
+
+static void JsonSerialize_NonAscii(benchmark::State& state) {
+    const Maze::Element el = Maze::Element::from_json(Maze::Benchmarks::make_non_ascii_json((int)state.range(0)));
+    size_t bytes = 0;
+
+    for (auto _ : state) {
+        std::string output = el.to_json(-1);
+        bytes += output.size();
+        benchmark::DoNotOptimize(output);
+    }
+
+    state.SetBytesProcessed(bytes);
+}
+BENCHMARK(JsonSerialize_NonAscii)->Arg(5000);
+
+static void JsonSerialize_ReusedBuffer(benchmark::State& state) {
+    const Maze::Element el = Maze::Element::from_json(Maze::Benchmarks::make_records_json(100));
+    std::string output;
+    size_t bytes = 0;
+
+    for (auto _ : state) {
+        output.clear();
+        el.to_json(output, -1);
+        bytes += output.size();
+        benchmark::DoNotOptimize(output);
+    }
+
+    state.SetBytesProcessed(bytes);
+}
+BENCHMARK(JsonSerialize_ReusedBuffer);
+
+static void JsonSerialize_FreshString(benchmark::State& state) {
+    const Maze::Element el = Maze::Element::from_json(Maze::Benchmarks::make_records_json(100));
+    size_t bytes = 0;
+
+    for (auto _ : state) {
+        std::string output = el.to_json(-1);
+        bytes += output.size();
+        benchmark::DoNotOptimize(output);
+    }
+
+    state.SetBytesProcessed(bytes);
+}
+BENCHMARK(JsonSerialize_FreshString);
+
+static void JsonSerialize_JsonSize(benchmark::State& state) {
+    const Maze::Element el = Maze::Element::from_json(Maze::Benchmarks::make_records_json(10000));
+    const bool use_cache = state.range(0) != 0;
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(el.json_size(-1, use_cache));
+    }
+}
+BENCHMARK(JsonSerialize_JsonSize)->Arg(0)->Arg(1);
+
+// to_json allocates its result once when the size of the tree is cached
+static void JsonSerialize_CachedSize(benchmark::State& state) {
+    const Maze::Element el = Maze::Element::from_json(Maze::Benchmarks::make_records_json(10000));
+    el.json_size(-1, true);
+    size_t bytes = 0;
+
+    for (auto _ : state) {
+        std::string output = el.to_json(-1);
+        bytes += output.size();
+        benchmark::DoNotOptimize(output);
+    }
+
+    state.SetBytesProcessed(bytes);
+}
+BENCHMARK(JsonSerialize_CachedSize);
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+
+// Responses made of large embedded documents, written to /dev/null
+static Maze::Element make_blob_response(int count) {
+    Maze::Element el(Maze::Type::Array);
+
+    for (int i = 0; i < count; ++i) {
+        Maze::Element item(Maze::Type::Object);
+        item.set("id", Maze::Element(i));
+        item.set("content_type", Maze::Element("text/html"));
+        item.set("body", Maze::Element(std::string(256 * 1024, (char)('a' + i % 26))));
+        el << std::move(item);
+    }
+
+    return el;
+}
+
+static void JsonSerialize_BlobsToJsonWrite(benchmark::State& state) {
+    const Maze::Element el = make_blob_response((int)state.range(0));
+    const int fd = open("/dev/null", O_WRONLY);
+    size_t bytes = 0;
+
+    for (auto _ : state) {
+        el.to_json_fd(fd, -1);
+        bytes += el.json_size(-1, true);
+    }
+
+    close(fd);
+    state.SetBytesProcessed(bytes);
+}
+BENCHMARK(JsonSerialize_BlobsToJsonWrite)->Arg(64);
+
+static void JsonSerialize_BlobsSegmentsWritev(benchmark::State& state) {
+    const Maze::Element el = make_blob_response((int)state.range(0));
+    const int fd = open("/dev/null", O_WRONLY);
+    size_t bytes = 0;
+
+    for (auto _ : state) {
+        Maze::JsonSegments segments(el, -1);
+        segments.write_fd(fd);
+        bytes += segments.size();
+    }
+
+    close(fd);
+    state.SetBytesProcessed(bytes);
+}
+BENCHMARK(JsonSerialize_BlobsSegmentsWritev)->Arg(64);
+#endif
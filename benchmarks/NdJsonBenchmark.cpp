@@ -0,0 +1,40 @@
+#include <benchmark/benchmark.h>
+#include <Maze/Maze.hpp>
+#include <Maze/NdJson.hpp>
+
+static std::string make_lines(int count) {
+    std::string input;
+
+    for (int i = 0; i < count; ++i) {
+        input += R"({"id":)" + std::to_string(i) + R"(,"user":"user_)" + std::to_string(i * 7919 % 100000)
+            + R"(","status":200,"latency":12.5,"tags":["alpha","beta"],"geo":{"lat":46.05,"lon":14.5}})" + "\n";
+    }
+
+    return input;
+}
+
+static void NdJson_Parse(benchmark::State& state) {
+    const std::string input = make_lines(100000);
+
+    for (auto _ : state) {
+        std::vector<Maze::Element> elements = Maze::NdJson::parse(input, (unsigned int)state.range(0));
+        benchmark::DoNotOptimize(elements);
+    }
+
+    state.SetBytesProcessed(state.iterations() * input.size());
+}
+BENCHMARK(NdJson_Parse)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->UseRealTime();
+
+static void NdJson_Write(benchmark::State& state) {
+    const std::vector<Maze::Element> elements = Maze::NdJson::parse(make_lines(100000));
+    size_t bytes = 0;
+
+    for (auto _ : state) {
+        std::string output = Maze::NdJson::write(elements, (unsigned int)state.range(0));
+        bytes += output.size();
+        benchmark::DoNotOptimize(output);
+    }
+
+    state.SetBytesProcessed(bytes);
+}
+BENCHMARK(NdJson_Write)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->UseRealTime();
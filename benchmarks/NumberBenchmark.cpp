@@ -0,0 +1,85 @@
+#include <benchmark/benchmark.h>
+#include <Maze/Maze.hpp>
+#include <string>
+
+// Number dense arrays, like metric samples and geo coordinates
+
+static std::string make_doubles_json(int count) {
+    std::string json = "[";
+
+    for (int i = 0; i < count; ++i) {
+        if (i > 0)
+            json += ",";
+
+        json += Maze::Element(46.0 + i * 0.000123457).to_json(-1) + "," + Maze::Element(-14.5 - i / 7.0).to_json(-1);
+    }
+
+    json += "]";
+    return json;
+}
+
+static std::string make_ints_json(int count) {
+    std::string json = "[";
+
+    for (int i = 0; i < count; ++i) {
+        if (i > 0)
+            json += ",";
+
+        json += std::to_string((i * 2654435761u) % 2000000 - 1000000);
+    }
+
+    json += "]";
+    return json;
+}
+
+static void Number_ParseDoubles(benchmark::State& state) {
+    const std::string input = make_doubles_json((int)state.range(0));
+
+    for (auto _ : state) {
+        Maze::Element el = Maze::Element::from_json(input);
+        benchmark::DoNotOptimize(el);
+    }
+
+    state.SetBytesProcessed(state.iterations() * input.size());
+}
+BENCHMARK(Number_ParseDoubles)->Arg(50000);
+
+static void Number_SerializeDoubles(benchmark::State& state) {
+    const Maze::Element el = Maze::Element::from_json(make_doubles_json((int)state.range(0)));
+    size_t bytes = 0;
+
+    for (auto _ : state) {
+        std::string output = el.to_json(-1);
+        bytes += output.size();
+        benchmark::DoNotOptimize(output);
+    }
+
+    state.SetBytesProcessed(bytes);
+}
+BENCHMARK(Number_SerializeDoubles)->Arg(50000);
+
+static void Number_ParseInts(benchmark::State& state) {
+    const std::string input = make_ints_json((int)state.range(0));
+
+    for (auto _ : state) {
+        Maze::Element el = Maze::Element::from_json(input);
+        benchmark::DoNotOptimize(el);
+    }
+
+    state.SetBytesProcessed(state.iterations() * input.size());
+}
+BENCHMARK(Number_ParseInts)->Arg(100000);
+
+static void Number_SerializeInts(benchmark::State& state) {
+    const Maze::Element el = Maze::Element::from_json(make_ints_json((int)state.range(0)));
+    size_t bytes = 0;
+
+    for (auto _ : state) {
+        std::string output = el.to_json(-1);
+        bytes += output.size();
+        benchmark::DoNotOptimize(output);
+    }
+
+    state.SetBytesProcessed(bytes);
+}
+BENCHMARK(Number_SerializeInts)->Arg(100000);
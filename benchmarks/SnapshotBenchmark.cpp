@@ -0,0 +1,34 @@
+#include <benchmark/benchmark.h>
+#include <Maze/Maze.hpp>
+#include <Maze/Snapshot.hpp>
+#include <cstdio>
+#include <fstream>
+#include "BenchmarkData.hpp"
+
+// Startup cost of loading a catalog like document and reading a few values from it
+
+static void Snapshot_LoadJsonFile(benchmark::State& state) {
+    const std::string path = "maze_benchmark_catalog.json";
+    std::ofstream(path, std::ios::binary) << Maze::Benchmarks::make_records_json((int)state.range(0));
+
+    for (auto _ : state) {
+        Maze::Element el = Maze::Element::from_json_file(path);
+        benchmark::DoNotOptimize(el[42]["user"].s().size() + el[1000]["geo"]["lat"].d());
+    }
+
+    std::remove(path.c_str());
+}
+BENCHMARK(Snapshot_LoadJsonFile)->Arg(10000);
+
+static void Snapshot_OpenFile(benchmark::State& state) {
+    const std::string path = "maze_benchmark_catalog.snapshot";
+    Maze::Snapshot::write_file(Maze::Element::from_json(Maze::Benchmarks::make_records_json((int)state.range(0))), path);
+
+    for (auto _ : state) {
+        Maze::Snapshot snapshot = Maze::Snapshot::open_file(path);
+        benchmark::DoNotOptimize(snapshot.root()[42]["user"].get_string().size() + snapshot.root()[1000]["geo"]["lat"].get_double());
+    }
+
+    std::remove(path.c_str());
+}
+BENCHMARK(Snapshot_OpenFile)->Arg(10000);
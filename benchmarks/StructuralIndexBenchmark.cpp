@@ -0,0 +1,49 @@
+#include <benchmark/benchmark.h>
+#include <Maze/StructuralIndex.hpp>
+#include <Maze/Maze.hpp>
+#include <string>
+#include "BenchmarkData.hpp"
+
+using Maze::StructuralIndex;
+
+static std::string make_payload(int64_t payload) {
+    switch (payload) {
+    case 0:
+        return Maze::Benchmarks::make_records_json(20000);
+    case 1:
+        return Maze::Benchmarks::make_wide_object_json(20000);
+    default: {
+        std::string json = "[";
+        for (int i = 0; i < 50000; ++i) {
+            if (i > 0)
+                json += ",";
+
+            json += Maze::Element(46.0 + i * 0.000123457).to_json(-1);
+        }
+
+        return json + "]";
+    }
+    }
+}
+
+// Arguments are the implementation and the payload: records, wide object, doubles
+static void StructuralIndex_Scan(benchmark::State& state) {
+    const auto implementation = (StructuralIndex::Implementation)state.range(0);
+    if (!StructuralIndex::is_supported(implementation)) {
+        state.SkipWithError("Implementation not supported on this CPU");
+        return;
+    }
+
+    const std::string input = make_payload(state.range(1));
+    std::vector<uint32_t> positions;
+
+    for (auto _ : state) {
+        StructuralIndex index(implementation);
+        positions.clear();
+        index.scan(input.data(), (uint32_t)input.size(), positions);
+        benchmark::DoNotOptimize(positions.data());
+    }
+
+    state.SetBytesProcessed(state.iterations() * input.size());
+}
+BENCHMARK(StructuralIndex_Scan)->ArgsProduct({ { 0, 1, 2 }, { 0, 1, 2 } });
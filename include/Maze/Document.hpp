@@ -0,0 +1,63 @@
+#pragma once
+
+#include <atomic>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <Maze/Maze.hpp>
+#include <Maze/DLLSupport.hpp>
+
+namespace Maze {
+
+    // Owns an element tree allocated from a monotonic arena, containers with their
+    // lists of children and keys as well as string values, so a request scoped tree
+    // is built without individual heap allocations. reset() releases the arena without
+    // visiting the tree, unless something in it keeps memory from elsewhere:
+    //   - object keys past the permanent part of the process wide key table
+    //   - caches built on first use, which const readers may build concurrently
+    //     while the arena is not thread safe: the key index of wide objects, the
+    //     strings returned by get_keys() and sizes kept by json_size()
+    //   - values written through mutable references to children, from operator[],
+    //     emplace(), begin() and the like, which do not know about the arena
+    // The tree is then destroyed before the arena is released, as it would be with
+    // any other resource. Elements moved out of the document keep pointing into the
+    // arena, copy them instead if they need to outlive it.
+    class Document {
+    public:
+        // Monotonic arena that remembers whether a tree allocated from it holds memory from elsewhere
+        class Arena : public std::pmr::monotonic_buffer_resource {
+        public:
+            using std::pmr::monotonic_buffer_resource::monotonic_buffer_resource;
+
+            inline void mark_external() noexcept { _external.store(true, std::memory_order_relaxed); }
+            inline bool holds_external() const noexcept { return _external.load(std::memory_order_relaxed); }
+            inline void release() { std::pmr::monotonic_buffer_resource::release(); _external.store(false, std::memory_order_relaxed); }
+
+        private:
+            std::atomic<bool> _external = false;
+        };
+
+        MAZE_API explicit Document(size_t initial_size = 4096, std::pmr::memory_resource* upstream = std::pmr::get_default_resource());
+
+        Document(const Document&) = delete;
+        Document& operator=(const Document&) = delete;
+
+        MAZE_API inline Element& root() { return _root; }
+        MAZE_API inline const Element& root() const { return _root; }
+        MAZE_API inline std::pmr::memory_resource* get_resource() { return &_arena; }
+
+        MAZE_API Element& parse(std::string_view json_string);
+        MAZE_API Element& parse_file(const std::string& path);
+        MAZE_API Element& set_root(Type type);
+        MAZE_API Element create(Type type);
+
+        MAZE_API void reset();
+
+    protected:
+        Arena _arena;
+
+        // Declared after the arena so the tree is destroyed before its memory
+        Element _root;
+    };
+
+}  // namespace Maze
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <Maze/Maze.hpp>
+#include <Maze/DLLSupport.hpp>
+
+namespace Maze {
+
+    // Incremental JSON parser for input that arrives in chunks. Every chunk is
+    // parsed as soon as it is fed, tokens split across chunks are carried over,
+    // so the whole input never has to be in one buffer. finish() returns the
+    // parsed element once the input has ended.
+    //
+    // After an error the parser stays failed until reset().
+    class JsonPushParser {
+    public:
+        MAZE_API explicit JsonPushParser(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+        JsonPushParser(const JsonPushParser&) = delete;
+        JsonPushParser& operator=(const JsonPushParser&) = delete;
+
+        MAZE_API void feed(std::string_view chunk);
+        MAZE_API inline void feed(const char* data, size_t size) { feed(std::string_view(data, size)); }
+
+        // True once a complete value was read, only whitespace may follow
+        MAZE_API bool is_complete() const;
+
+        MAZE_API Element finish();
+        MAZE_API void reset();
+
+        // Bytes fed since the last reset
+        MAZE_API inline size_t get_offset() const { return _offset; }
+
+    protected:
+        enum class State {
+            Value,
+            ArrayFirst,
+            ObjectFirst,
+            Key,
+            Colon,
+            AfterValue,
+            String,
+            KeyString,
+            Scalar,
+            Done,
+            Failed
+        };
+
+        struct Frame {
+            Element* container;
+            bool is_object;
+        };
+
+        const char* parse_structure(const char* pos);
+        const char* parse_string(const char* pos, const char* end);
+        const char* parse_scalar(const char* pos, const char* end);
+
+        void begin_value(const char* pos);
+        Element& new_value();
+        void end_container();
+        void end_string(const char* pos);
+        void end_scalar(const char* pos);
+        void end_value();
+
+        [[noreturn]] void fail(const std::string& message, const char* pos);
+
+        std::pmr::memory_resource* _resource;
+
+        State _state = State::Value;
+        std::vector<Frame> _stack;
+        Element _root;
+
+        // Value that the current string or scalar is parsed into
+        Element* _target = nullptr;
+        Element::Key _key;
+
+        // Current token, string contents are kept without their quotes
+        std::string _token;
+        bool _escaped = false;
+        bool _needs_decoding = false;
+
+        const char* _chunk = nullptr;
+        size_t _offset = 0;
+    };
+
+}  // namespace Maze
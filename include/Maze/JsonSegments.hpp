@@ -0,0 +1,46 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <Maze/Maze.hpp>
+#include <Maze/DLLSupport.hpp>
+
+namespace Maze {
+
+    // JSON of an element as a list of segments for scatter/gather writes. Runs
+    // of string values that need no escaping and are at least
+    // min_reference_size long point into the element itself, everything else is
+    // written to a scratch buffer owned by this object.
+    //
+    // Segments are only valid while the element they were made from is alive
+    // and unmodified.
+    class JsonSegments {
+    public:
+        struct Segment {
+            const char* data;
+            size_t size;
+        };
+
+        MAZE_API explicit JsonSegments(const Element& el, int indentation_spacing = 2, size_t min_reference_size = default_min_reference_size);
+
+        MAZE_API inline const std::vector<Segment>& segments() const { return _segments; }
+
+        // Total length of the JSON
+        MAZE_API inline size_t size() const { return _size; }
+
+        MAZE_API std::string to_string() const;
+
+        // Writes every segment to a file descriptor, with writev where available
+        MAZE_API void write_fd(int file_descriptor) const;
+
+        static const size_t default_min_reference_size = 1024;
+
+    private:
+        // Kept behind a pointer so moving this object does not move the segments it points to
+        std::unique_ptr<std::string> _scratch;
+        std::vector<Segment> _segments;
+        size_t _size = 0;
+    };
+
+}  // namespace Maze
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <functional>
+#include <istream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <Maze/Maze.hpp>
+#include <Maze/DLLSupport.hpp>
+
+namespace Maze {
+
+    // Reads a JSON document incrementally and hands every element found at the
+    // configured path to a callback, so memory stays bounded by the largest
+    // single element instead of the whole document.
+    //
+    // The path lists object keys leading from the root to the streamed value.
+    // If that value is an array each of its items is passed on its own,
+    // otherwise the value itself is. Everything outside the path is skipped
+    // without building elements, but must still be valid JSON.
+    class JsonStream {
+    public:
+        using Callback = std::function<void(Element&&)>;
+
+        MAZE_API explicit JsonStream(Callback callback, std::vector<std::string> path = {});
+
+        MAZE_API void parse(std::istream& stream);
+        MAZE_API void parse(std::string_view json_string);
+        MAZE_API void parse_file(const std::string& path);
+
+        // Number of elements passed to the callback by the last parse
+        MAZE_API inline size_t count() const { return _count; }
+
+        static const size_t buffer_size = 64 * 1024;
+
+    protected:
+        void parse_root();
+        void parse_level(size_t level);
+        void parse_items();
+        void emit_value();
+
+        bool refill();
+        int peek();
+        char next();
+        void skip_whitespace();
+        void expect(char c);
+        void read_value(std::string* target);
+        void skip_value();
+        void skip_key();
+        void skip_scalar();
+        void read_string(std::string* target);
+        void decode_key();
+
+        [[noreturn]] void fail(const std::string& message) const;
+
+        Callback _callback;
+        std::vector<std::string> _path;
+        size_t _count = 0;
+
+        std::istream* _stream = nullptr;
+        std::vector<char> _buffer;
+        const char* _begin = nullptr;
+        const char* _pos = nullptr;
+        const char* _end = nullptr;
+
+        // Bytes consumed before the current buffer
+        size_t _offset = 0;
+
+        std::string _value;
+        std::string _key;
+        std::string _token;
+    };
+
+}  // namespace Maze
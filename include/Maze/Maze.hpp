@@ -1,11 +1,20 @@
 #pragma once
 
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <iosfwd>
 #include <string>
 #include <memory>
+#include <memory_resource>
+#include <string_view>
+#include <type_traits>
+#include <utility>
 #include <vector>
 #include <Maze/DLLSupport.hpp>
 
 #define MAZE_ARRAY_INDEX_PREFIX_CHAR '~'
+#define MAZE_OBJECT_KEY_INDEX_THRESHOLD 32
 
 namespace Maze {
     
@@ -45,35 +54,55 @@ namespace Maze {
 
 
     class Element {
+        friend class JsonParser;
+        friend class JsonWriter;
+        friend class JsonPushParser;
+        friend class MsgPackReader;
+        friend class MsgPackWriter;
+        friend class CborReader;
+        friend class CborWriter;
+        friend class SnapshotWriter;
+        friend class KeyTable;
+        friend class Document;
+
     public:
 #pragma region Constructors/destructor
 
         MAZE_API inline Element() { set_as_null(); }
         MAZE_API inline Element(const Element& val) { copy_from_element(val); }
+        // Moves the value only, as with copies the key stays with the element moved from
+        MAZE_API inline Element(Element&& val) noexcept { take_value(val); }
         MAZE_API inline Element(bool val) { set_bool(val); }
         MAZE_API inline Element(int val) { set_int(val); }
         MAZE_API inline Element(double val) { set_double(val); }
         MAZE_API inline Element(const std::string& val) { set_string(val); }
+        MAZE_API inline Element(std::string_view val) { set_string(val); }
+        MAZE_API inline Element(std::pmr::string&& val) { set_string(std::move(val)); }
         MAZE_API inline Element(const char* val) { set_string(val); }
         MAZE_API inline Element(const std::vector<Element>& val) { set_array(val); }
+        MAZE_API inline Element(std::vector<Element>&& val) { set_array(std::move(val)); }
         MAZE_API inline Element(const std::vector<std::string>& keys, const std::vector<Element>& val) { set_object(keys, val); }
+        MAZE_API inline Element(std::vector<std::string>&& keys, std::vector<Element>&& val) { set_object(std::move(keys), std::move(val)); }
         MAZE_API inline Element(FunctionCallback callback) { set_function(callback); }
         MAZE_API inline Element(Type val) { set_type(val); }
-        MAZE_API inline ~Element() {}
+        MAZE_API Element(Type val, std::pmr::memory_resource* resource);
+        MAZE_API inline ~Element() { if (_type == Type::String || is_container()) release_value(); }
 
 #pragma endregion
 
 
         MAZE_API inline void operator=(const Element& val) { copy_from_element(val); }
+        MAZE_API inline void operator=(Element&& val) noexcept { steal_value(val); }
         MAZE_API void copy_from_element(const Element& val);
 
         MAZE_API void set_type(const Type& type);
         MAZE_API inline const Type& get_type() const { return _type; }
         MAZE_API inline Type& get_type_ref() { return _type; }
 
-        MAZE_API inline void set_key(const std::string& key) { _val_key = key; }
-        MAZE_API inline const std::string& get_key() const { return _val_key; }
-        MAZE_API inline std::string& get_key_ref() { return _val_key; }
+        // Keys are interned and shared between elements, so there is no mutable
+        // reference to them. Rename children of an object with rename_key().
+        MAZE_API void set_key(std::string_view key);
+        MAZE_API const std::string& get_key() const;
 
         MAZE_API void set_as_null(bool clear_existing_values = true);
 
@@ -90,7 +119,7 @@ namespace Maze {
         //   Setters
         MAZE_API inline void b(bool val) { set_bool(val); }
         MAZE_API inline void operator=(bool val) { set_bool(val); }
-        MAZE_API inline void set_bool(bool val) { _val_bool = val; _type = Type::Bool; }
+        MAZE_API inline void set_bool(bool val) { reset_value(); _val_bool = val; _type = Type::Bool; }
 
 #pragma endregion
 
@@ -107,7 +136,7 @@ namespace Maze {
         //   Setters
         MAZE_API inline void i(int val) { set_int(val); }
         MAZE_API inline void operator=(int val) { set_int(val); }
-        MAZE_API inline void set_int(int val) { _val_int = val; _type = Type::Int; }
+        MAZE_API inline void set_int(int val) { reset_value(); _val_int = val; _type = Type::Int; }
 
 #pragma endregion
 
@@ -123,26 +152,34 @@ namespace Maze {
         //   Setters
         MAZE_API inline void d(double val) { set_double(val); }
         MAZE_API inline void operator=(double val) { set_double(val); }
-        MAZE_API inline void set_double(double val) { _val_double = val; _type = Type::Double; }
+        MAZE_API inline void set_double(double val) { reset_value(); _val_double = val; _type = Type::Double; }
 
 #pragma endregion
 
 
 #pragma region String
 
+        // Strings are allocated from the resource of the container holding them, so
+        // getters return views. Copy them into a std::string to keep them around.
         //   Getters
-        MAZE_API inline const std::string& s() const { return get_string(); }
-        MAZE_API inline operator const std::string& () const { return get_string(); }
-        MAZE_API const std::string& get_string() const;
-        MAZE_API const std::string& get_string_const_ref(const std::string& fallback_value) const;
-        MAZE_API std::string get_string(const std::string& fallback_value) const;
-        MAZE_API std::string& get_string_ref();
+        MAZE_API inline std::string_view s() const { return get_string(); }
+        MAZE_API inline operator std::string_view() const { return get_string(); }
+        MAZE_API inline operator std::string() const { return std::string(get_string()); }
+        MAZE_API inline std::string_view get_string() const { return get_string(std::string_view()); }
+        MAZE_API std::string_view get_string(std::string_view fallback_value) const;
+        MAZE_API const std::pmr::string& get_string_const_ref(const std::pmr::string& fallback_value) const;
+        MAZE_API std::pmr::string& get_string_ref();
 
         //   Setters
-        MAZE_API inline void s(const std::string& val) { set_string(val); }
+        MAZE_API inline void s(std::string_view val) { set_string(val); }
         MAZE_API inline void operator=(const std::string& val) { set_string(val); }
+        MAZE_API inline void operator=(std::string_view val) { set_string(val); }
+        MAZE_API inline void operator=(std::pmr::string&& val) { set_string(std::move(val)); }
         MAZE_API inline void operator=(const char* val) { set_string(val); }
-        MAZE_API inline void set_string(const std::string& val) { _val_string = val; _type = Type::String; }
+        MAZE_API void set_string(std::string_view val);
+        MAZE_API inline void set_string(const char* val) { set_string(std::string_view(val)); }
+        // Adopts the characters along with the resource they were allocated from
+        MAZE_API void set_string(std::pmr::string&& val);
 
 #pragma endregion
 
@@ -151,6 +188,24 @@ namespace Maze {
 
         static const char array_index_prefix_char = MAZE_ARRAY_INDEX_PREFIX_CHAR;
 
+        // Allocator of the children of containers. Children relocated by their vector
+        // keep their keys, which moving an element on its own does not do.
+        class ChildAllocator : public std::pmr::polymorphic_allocator<Element> {
+        public:
+            template <typename T>
+            struct rebind { typedef std::conditional_t<std::is_same_v<T, Element>, ChildAllocator, std::pmr::polymorphic_allocator<T>> other; };
+
+            ChildAllocator() noexcept = default;
+            ChildAllocator(std::pmr::memory_resource* resource) noexcept : std::pmr::polymorphic_allocator<Element>(resource) {}
+
+            ChildAllocator select_on_container_copy_construction() const { return ChildAllocator(); }
+
+            template <typename T, typename... Args>
+            void construct(T* p, Args&&... args) { std::pmr::polymorphic_allocator<Element>::construct(p, std::forward<Args>(args)...); }
+            void construct(Element* p, Element&& val) noexcept { new (p) Element(std::move(val)); p->_key = std::move(val._key); }
+        };
+        typedef std::vector<Element, ChildAllocator> ChildVector;
+
         //   Getters
         MAZE_API inline const Element& operator[](int index) const { return get(index); }
         MAZE_API const Element& get(int index) const;
@@ -162,71 +217,95 @@ namespace Maze {
 
         //   Setters
         MAZE_API void set_array(const std::vector<Element>& val);
+        MAZE_API void set_array(std::vector<Element>&& val);
         MAZE_API inline Element& operator<<(const std::string& value) { return push_back(value); }
+        MAZE_API inline Element& operator<<(std::string_view value) { return push_back(value); }
         MAZE_API inline Element& operator<<(const char* value) { return push_back(value); }
         MAZE_API inline Element& operator<<(bool value) { return push_back(value); }
         MAZE_API inline Element& operator<<(int value) { return push_back(value); }
         MAZE_API inline Element& operator<<(double value) { return push_back(value); }
         MAZE_API inline Element& operator<<(const Element& value) { return push_back(value); }
+        MAZE_API inline Element& operator<<(Element&& value) { return push_back(std::move(value)); }
         MAZE_API inline Element& push_back(const std::string& value) { return push_back(Element(value)); }
+        MAZE_API inline Element& push_back(std::string_view value) { return push_back(Element(value)); }
         MAZE_API inline Element& push_back(const char* value) { return push_back(Element(value)); }
         MAZE_API inline Element& push_back(bool value) { return push_back(Element(value)); }
         MAZE_API inline Element& push_back(int value) { return push_back(Element(value)); }
         MAZE_API inline Element& push_back(double value) { return push_back(Element(value)); }
-        MAZE_API Element& push_back(const Element& value);
+        MAZE_API inline Element& push_back(const Element& value) { return push_back(Element(value)); }
+        MAZE_API Element& push_back(Element&& value);
+        template <typename... Args>
+        inline Element& emplace_back(Args&&... args) { push_back(Element(std::forward<Args>(args)...)); return borrow_children().values.back(); }
+
+        MAZE_API void reserve(size_t capacity);
+        MAZE_API inline size_t capacity() const { return is_container() ? get_storage().values.capacity() : 0; }
+        MAZE_API void shrink_to_fit();
 
         MAZE_API void remove_at(int index, bool update_string_indexes = true);
-        MAZE_API inline void remove_all_children() { _children.clear(); _children_keys.clear(); }
-        MAZE_API inline size_t count_children() const { return _children_keys.size(); }
-        MAZE_API inline bool has_children() const { return _children_keys.size() > 0; }
-        MAZE_API inline const std::vector<Element>& get_children() const { return _children; }
+        MAZE_API Element take(int index);
+        MAZE_API void remove_all_children();
+        MAZE_API inline size_t count_children() const { return is_container() ? get_storage().values.size() : 0; }
+        MAZE_API inline bool has_children() const { return count_children() > 0; }
+        MAZE_API const ChildVector& get_children() const;
 
-        MAZE_API inline const std::vector<Element>::const_iterator begin() const { return _children.begin(); }
-        MAZE_API inline const std::vector<Element>::const_iterator end() const { return _children.end(); }
-        MAZE_API inline std::vector<Element>::iterator begin() { return _children.begin(); }
-        MAZE_API inline std::vector<Element>::iterator end() { return _children.end(); }
+        MAZE_API inline const ChildVector::const_iterator begin() const { return get_children().begin(); }
+        MAZE_API inline const ChildVector::const_iterator end() const { return get_children().end(); }
+        MAZE_API ChildVector::iterator begin();
+        MAZE_API ChildVector::iterator end();
 
 #pragma endregion
 
 
 #pragma region Object
 
+        static const size_t object_key_index_threshold = MAZE_OBJECT_KEY_INDEX_THRESHOLD;
+
         //   Getters
-        MAZE_API inline const Element& operator[](const std::string& key) const { return get(key); }
+        MAZE_API inline const Element& operator[](std::string_view key) const { return get(key); }
         MAZE_API inline const Element& operator[](const char* key) const { return get(key); }
-        MAZE_API const Element& get(const std::string& key) const;
-        MAZE_API const Element& get_const_ref(const std::string& key, const Element& fallback_value) const;
-        MAZE_API Element get(const std::string& key, const Element& fallback_value) const;
-        MAZE_API inline Element& operator[](const std::string& key) { return get_ref(key); }
+        MAZE_API const Element& get(std::string_view key) const;
+        MAZE_API const Element& get_const_ref(std::string_view key, const Element& fallback_value) const;
+        MAZE_API Element get(std::string_view key, const Element& fallback_value) const;
+        MAZE_API inline Element& operator[](std::string_view key) { return get_ref(key); }
         MAZE_API inline Element& operator[](const char* key) { return get_ref(key); }
-        MAZE_API inline Element& get_ref(const std::string& key) { return *get_ptr(key); }
-        MAZE_API Element* get_ptr(const std::string& key);
+        MAZE_API inline Element& get_ref(std::string_view key) { return *get_ptr(key); }
+        MAZE_API Element* get_ptr(std::string_view key);
 
         //   Setters
         MAZE_API void set_object(const std::vector<std::string>& keys, const std::vector<Element>& values);
-        MAZE_API inline void set(const std::string& key, const std::string& value) { set(key, Element(value)); }
-        MAZE_API inline void set(const std::string& key, const char* value) { set(key, Element(value)); }
-        MAZE_API inline void set(const std::string& key, bool value) { set(key, Element(value)); }
-        MAZE_API inline void set(const std::string& key, int value) { set(key, Element(value)); }
-        MAZE_API inline void set(const std::string& key, double value) { set(key, Element(value)); }
-        MAZE_API void set(const std::string& key, const Element& value);
-
-        MAZE_API void remove(const std::string& key, bool update_string_indexes = true);
-        MAZE_API bool exists(const std::string& key) const;
-        MAZE_API int index_of(const std::string& key) const;
-        MAZE_API inline const std::vector<std::string>& get_keys() const { return _children_keys; }
-
-        MAZE_API inline const std::vector<std::string>::const_iterator keys_begin() const { return _children_keys.begin(); }
-        MAZE_API inline const std::vector<std::string>::const_iterator keys_end() const { return _children_keys.end(); }
-        MAZE_API inline std::vector<std::string>::iterator keys_begin() { return _children_keys.begin(); }
-        MAZE_API inline std::vector<std::string>::iterator keys_end() { return _children_keys.end(); }
+        MAZE_API void set_object(std::vector<std::string>&& keys, std::vector<Element>&& values);
+        MAZE_API inline void set(std::string_view key, const std::string& value) { set(key, Element(value)); }
+        MAZE_API inline void set(std::string_view key, std::string_view value) { set(key, Element(value)); }
+        MAZE_API inline void set(std::string_view key, const char* value) { set(key, Element(value)); }
+        MAZE_API inline void set(std::string_view key, bool value) { set(key, Element(value)); }
+        MAZE_API inline void set(std::string_view key, int value) { set(key, Element(value)); }
+        MAZE_API inline void set(std::string_view key, double value) { set(key, Element(value)); }
+        MAZE_API inline void set(std::string_view key, const Element& value) { set(key, Element(value)); }
+        MAZE_API inline void set(std::string_view key, Element&& value) { set_value(key, std::move(value)); }
+        template <typename... Args>
+        inline Element& emplace(std::string_view key, Args&&... args) { const size_t index = set_value(key, Element(std::forward<Args>(args)...)); return borrow_children().values[index]; }
+        MAZE_API void set_many(const std::vector<std::string>& keys, const std::vector<Element>& values, bool keys_are_unique = false);
+        MAZE_API void set_many(std::vector<std::string>&& keys, std::vector<Element>&& values, bool keys_are_unique = false);
+
+        // Replaces the key of a child in place. Throws when another child already uses the new key.
+        MAZE_API void rename_key(int index, std::string_view new_key);
+        MAZE_API void rename_key(std::string_view key, std::string_view new_key);
+
+        MAZE_API void remove(std::string_view key, bool update_string_indexes = true);
+        MAZE_API Element take(std::string_view key);
+        MAZE_API bool exists(std::string_view key) const;
+        MAZE_API int index_of(std::string_view key) const;
+        MAZE_API const std::vector<std::string>& get_keys() const;
+
+        MAZE_API inline const std::vector<std::string>::const_iterator keys_begin() const { return get_keys().begin(); }
+        MAZE_API inline const std::vector<std::string>::const_iterator keys_end() const { return get_keys().end(); }
 
 #pragma endregion
 
 
 #pragma region Function
 
-        MAZE_API inline void set_function(FunctionCallback callback) { _callback = callback; _type = Type::Function; }
+        MAZE_API inline void set_function(FunctionCallback callback) { reset_value(); _callback = callback; _type = Type::Function; }
 
         MAZE_API inline Element e(const Element& value) const { return execute_function(value); }
         MAZE_API Element execute_function(const Element& value) const;
@@ -246,6 +325,7 @@ namespace Maze {
         MAZE_API inline bool is_object() const { return is(Type::Object); }
         MAZE_API inline bool is_function() const { return is(Type::Function); }
         MAZE_API inline bool is(Type type) const { return _type == type; }
+        MAZE_API inline bool is_container() const { return _type == Type::Array || _type == Type::Object; }
 
         MAZE_API inline bool is_null(int index) const { return is(index, Type::Null); }
         MAZE_API inline bool is_bool(int index) const { return is(index, Type::Bool); }
@@ -257,41 +337,210 @@ namespace Maze {
         MAZE_API inline bool is_function(int index) const { return is(index, Type::Function); }
         MAZE_API inline bool is(int index, Type type) const { return get(index).is(type); }
 
-        MAZE_API inline bool is_null(const std::string& key) const { return is(key, Type::Null); }
-        MAZE_API inline bool is_bool(const std::string& key) const { return is(key, Type::Bool); }
-        MAZE_API inline bool is_int(const std::string& key) const { return is(key, Type::Int); }
-        MAZE_API inline bool is_double(const std::string& key) const { return is(key, Type::Double); }
-        MAZE_API inline bool is_string(const std::string& key) const { return is(key, Type::String); }
-        MAZE_API inline bool is_array(const std::string& key) const { return is(key, Type::Array); }
-        MAZE_API inline bool is_object(const std::string& key) const { return is(key, Type::Object); }
-        MAZE_API inline bool is_function(const std::string& key) const { return is(key, Type::Function); }
-        MAZE_API inline bool is(const std::string& key, Type type) const { return get(key).is(type); }
+        MAZE_API inline bool is_null(std::string_view key) const { return is(key, Type::Null); }
+        MAZE_API inline bool is_bool(std::string_view key) const { return is(key, Type::Bool); }
+        MAZE_API inline bool is_int(std::string_view key) const { return is(key, Type::Int); }
+        MAZE_API inline bool is_double(std::string_view key) const { return is(key, Type::Double); }
+        MAZE_API inline bool is_string(std::string_view key) const { return is(key, Type::String); }
+        MAZE_API inline bool is_array(std::string_view key) const { return is(key, Type::Array); }
+        MAZE_API inline bool is_object(std::string_view key) const { return is(key, Type::Object); }
+        MAZE_API inline bool is_function(std::string_view key) const { return is(key, Type::Function); }
+        MAZE_API inline bool is(std::string_view key, Type type) const { return get(key).is(type); }
 
 #pragma endregion
 
 
+        // Memory resource the children of this container, or the characters of this
+        // string, are allocated from. Children moved into a container are moved over
+        // to its resource.
+        MAZE_API std::pmr::memory_resource* get_resource() const;
+
         MAZE_API void apply(const Element& new_element);
 
         MAZE_API std::string to_json(int indentation_spacing = 2) const;
-
-        MAZE_API void apply_json(const std::string& json_string);
-
-        MAZE_API static Element from_json(const std::string& json_string);
+        // Appends to output, so its capacity can be reused between calls
+        MAZE_API void to_json(std::string& output, int indentation_spacing = 2) const;
+
+        // Writes the JSON in chunks of at most 64 KiB instead of building the whole text.
+        // Write errors throw, leaving whatever was already written in place.
+        MAZE_API void to_json(std::ostream& stream, int indentation_spacing = 2) const;
+        MAZE_API void to_json(std::FILE* file, int indentation_spacing = 2) const;
+        MAZE_API void to_json_fd(int file_descriptor, int indentation_spacing = 2) const;
+
+        // Exact length of to_json(indentation_spacing), computed without generating it.
+        // With use_cache the sizes of containers are kept until they are changed and
+        // to_json allocates its result once. Containers that handed out mutable
+        // references to their children, through operator[], get_ptr(), begin() and
+        // the like, are measured every time, writes through those references could
+        // not be noticed.
+        MAZE_API size_t json_size(int indentation_spacing = 2, bool use_cache = false) const;
+
+        MAZE_API void apply_json(std::string_view json_string);
+
+        MAZE_API static Element from_json(std::string_view json_string);
+        MAZE_API static Element from_json(std::string_view json_string, std::pmr::memory_resource* resource);
+        MAZE_API static Element from_json(const char* data, size_t length);
+
+        // Maps the file into memory and parses it in place
+        MAZE_API static Element from_json_file(const std::string& path);
+        MAZE_API static Element from_json_file(const std::string& path, std::pmr::memory_resource* resource);
+
+        // Lazy mode only indexes the structure of the input up front. Arrays and objects
+        // parse their children when they are first accessed, so values that are never
+        // read are never parsed and errors inside them are never reported.
+        MAZE_API static Element from_json_lazy(std::string json_string);
+        MAZE_API static Element from_json_file_lazy(const std::string& path);
+
+        MAZE_API std::vector<uint8_t> to_msgpack() const;
+        MAZE_API static Element from_msgpack(const uint8_t* data, size_t size);
+        MAZE_API static Element from_msgpack(const std::vector<uint8_t>& data);
+
+        MAZE_API std::vector<uint8_t> to_cbor() const;
+        MAZE_API static Element from_cbor(const uint8_t* data, size_t size);
+        MAZE_API static Element from_cbor(const std::vector<uint8_t>& data);
 
         MAZE_API static const Element& get_null_element();
 
+        // Number of keys past the permanent part of the key table still named by
+        // some element. They are dropped again once no element uses them.
+        MAZE_API static size_t count_counted_keys();
+
     protected:
-        Type _type = Type::Null;
+        // Children of array and object elements live out of line so that scalar
+        // elements only pay for a single pointer in the value union.
+        struct KeyIndex;
+        struct LazySource;
+        struct JsonSize;
+
+        // Owned reference to an interned key. Keys past the permanent part of the key
+        // table are counted and released together with the last element naming them.
+        class Key {
+        public:
+            static const uint32_t counted_bit = 0x80000000u;
+
+            Key() = default;
+            // Adopts the reference of an id returned by the key table
+            explicit Key(uint32_t id) : _id(id) {}
+            Key(const Key& other) : _id(other._id) { if (is_counted()) acquire(_id); }
+            Key(Key&& other) noexcept : _id(other._id) { other._id = 0; }
+            Key& operator=(Key other) noexcept { std::swap(_id, other._id); return *this; }
+            ~Key() { if (is_counted()) release(_id); }
+
+            inline uint32_t id() const { return _id; }
+            inline bool is_counted() const { return (_id & counted_bit) != 0; }
+
+        private:
+            MAZE_API static void acquire(uint32_t id) noexcept;
+            MAZE_API static void release(uint32_t id) noexcept;
+
+            uint32_t _id = 0;
+        };
+
+        struct Children {
+            // Interned keys of object children, arrays keep keys empty. They hold
+            // references of their own, so counted keys stay alive as long as the
+            // container uses them, whatever happens to the keys of the children.
+            std::pmr::vector<Key> keys;
+            ChildVector values;
+
+            // Hash index over keys of wide objects. It is built on the first lookup once
+            // the object has object_key_index_threshold children and published atomically,
+            // so concurrent readers of a const object never observe a partial index.
+            mutable std::atomic<KeyIndex*> key_index = nullptr;
+
+            // Key strings for get_keys(), "~N" for arrays. They are only generated when
+            // requested and are cached until the keys change.
+            mutable std::atomic<std::vector<std::string>*> key_strings = nullptr;
+
+            // Set while the children of a lazily parsed container were not parsed yet
+            mutable std::atomic<LazySource*> lazy = nullptr;
+
+            // Size of the JSON of this container, kept by json_size() when asked to cache
+            // it. Dropped when the children are detached for a change, never kept while
+            // they are borrowed.
+            mutable std::atomic<JsonSize*> json_size = nullptr;
+
+            // Copies of an element share its children and the first one modified
+            // clones them.
+            std::atomic<size_t> ref_count = 1;
+
+            // Set once a mutable reference to a child was handed out. Writes through
+            // it would show in every copy sharing these children, so copies clone them
+            // instead, and nested children that are borrowed as well, from then on.
+            bool borrowed = false;
+
+            explicit Children(std::pmr::memory_resource* resource) : keys(resource), values(resource) {}
+            ~Children();
+
+            // Children are allocated from the same resource as their values
+            static Children* create(std::pmr::memory_resource* resource);
+            static void destroy(Children* children) noexcept;
+            static void release(Children* children) noexcept;
+            struct Deleter { void operator()(Children* children) const noexcept { release(children); } };
+            Children* clone(std::pmr::memory_resource* resource) const;
+            inline bool is_shared() const { return ref_count.load(std::memory_order_acquire) != 1; }
+            inline std::pmr::memory_resource* get_resource() const { return values.get_allocator().resource(); }
+            inline bool is_lazy() const { return lazy.load(std::memory_order_acquire) != nullptr; }
+            inline void materialize() const { if (is_lazy()) parse_lazy(); }
+            void parse_lazy() const;
+
+            // Tells a document arena holding these children that they keep memory from
+            // elsewhere, counted keys or caches, so it destroys them before it is released
+            void mark_external() const;
+            inline void track_key(const Key& key) const { if (key.is_counted()) mark_external(); }
+            inline void add_key(const Key& key) { track_key(key); keys.push_back(key); }
+            inline void set_key(size_t index, const Key& key) { track_key(key); keys[index] = key; }
+
+            int find_key(uint32_t key_id) const;
+            void key_appended();
+            void reset_key_index();
+            const std::vector<std::string>& get_key_strings() const;
+            void reset_key_strings();
+            void reset_json_size();
+            void renumber_index_keys(size_t from_index);
+            void erase(size_t index);
+
+            // Keeps the first position and the last value of every repeated key, like
+            // a sequence of set() calls would, in linear time.
+            void remove_duplicate_keys();
+        };
+
+        // Returned as a prvalue, so the key survives where a move would drop it
+        inline Element(Element&& val, Key key) noexcept : _key(std::move(key)) { take_value(val); }
+
+        inline void reset_value() { if (_type == Type::String || is_container()) release_value(); }
+        MAZE_API void release_value();
+        MAZE_API void take_value(Element& val) noexcept;
+        MAZE_API void steal_value(Element& val) noexcept;
+        MAZE_API size_t set_value(std::string_view key, Element&& value);
+        MAZE_API void copy_from_element(const Element& val, std::pmr::memory_resource* resource);
+        MAZE_API void set_container(Type type, std::pmr::memory_resource* resource);
+        // Replaces the value with an empty string allocated from resource
+        MAZE_API std::pmr::string& set_empty_string(std::pmr::memory_resource* resource);
+        // Drops the value without destroying it, its memory is released all at once
+        inline void forget_value() { _type = Type::Null; }
+        MAZE_API void move_to_resource(std::pmr::memory_resource* resource);
+        MAZE_API Children& detach_children();
+        // Detaches the children before a mutable reference into them is returned
+        MAZE_API Children& borrow_children();
+
+        inline const Children& get_storage() const { _val_children->materialize(); return *_val_children; }
 
-        bool _val_bool;
-        int _val_int;
-        double _val_double;
-        std::string _val_string;
-        std::vector<std::string> _children_keys;
-        std::vector<Element> _children;
-        FunctionCallback _callback;
+        Type _type = Type::Null;
 
-        std::string _val_key;
+        // Interned key of object children, 0 is the empty key. Next to the type so
+        // both fit in front of the value union.
+        Key _key;
+
+        // Only the member selected by _type is alive at any time.
+        union {
+            bool _val_bool;
+            int _val_int;
+            double _val_double;
+            std::pmr::string _val_string;
+            Children* _val_children;
+            FunctionCallback _callback;
+        };
     };
 
 }  // namespace Maze
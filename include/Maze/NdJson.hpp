@@ -0,0 +1,26 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <Maze/Maze.hpp>
+#include <Maze/DLLSupport.hpp>
+
+namespace Maze {
+
+    // Reads and writes newline delimited JSON (JSON Lines). Large inputs are
+    // split into blocks of whole lines that are processed on parallel threads,
+    // results always keep the input order. Blank lines are skipped and a thread
+    // count of 0 uses all hardware threads.
+    class NdJson {
+    public:
+        MAZE_API static std::vector<Element> parse(std::string_view input, unsigned int thread_count = 0);
+        MAZE_API static std::vector<Element> parse_file(const std::string& path, unsigned int thread_count = 0);
+        MAZE_API static std::string write(const std::vector<Element>& elements, unsigned int thread_count = 0);
+
+        // Inputs are not split into smaller blocks than this
+        static const size_t min_block_size = 64 * 1024;
+        static const size_t min_block_elements = 256;
+    };
+
+}  // namespace Maze
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <Maze/Maze.hpp>
+#include <Maze/DLLSupport.hpp>
+
+namespace Maze {
+
+    class MappedFile;
+
+    // Read-only view of a single value inside a snapshot. Values are read in
+    // place from the snapshot bytes, so views are cheap to copy and only valid
+    // while the snapshot they come from is alive. Accessors mirror the const
+    // Element ones: missing keys and indices give a null view and getters of
+    // a different type return the fallback value.
+    class SnapshotView {
+    public:
+        class Iterator;
+
+        MAZE_API inline SnapshotView() = default;
+
+        MAZE_API Type get_type() const;
+        MAZE_API inline bool is(Type type) const { return get_type() == type; }
+        MAZE_API inline bool is_null() const { return is(Type::Null); }
+        MAZE_API inline bool is_bool() const { return is(Type::Bool); }
+        MAZE_API inline bool is_int() const { return is(Type::Int); }
+        MAZE_API inline bool is_double() const { return is(Type::Double); }
+        MAZE_API inline bool is_string() const { return is(Type::String); }
+        MAZE_API inline bool is_array() const { return is(Type::Array); }
+        MAZE_API inline bool is_object() const { return is(Type::Object); }
+
+        MAZE_API bool get_bool(bool fallback_value = false) const;
+        MAZE_API int get_int(int fallback_value = 0) const;
+        MAZE_API double get_double(double fallback_value = 0.0) const;
+        MAZE_API std::string_view get_string(std::string_view fallback_value = std::string_view()) const;
+
+        // Key of this value in its parent object, empty otherwise
+        MAZE_API inline std::string_view get_key() const { return _key; }
+
+        MAZE_API size_t count_children() const;
+        MAZE_API SnapshotView get(int index) const;
+        MAZE_API SnapshotView get(std::string_view key) const;
+        MAZE_API inline SnapshotView operator[](int index) const { return get(index); }
+        MAZE_API inline SnapshotView operator[](std::string_view key) const { return get(key); }
+        MAZE_API inline SnapshotView operator[](const char* key) const { return get(std::string_view(key)); }
+        MAZE_API bool exists(std::string_view key) const;
+
+        MAZE_API inline Iterator begin() const;
+        MAZE_API inline Iterator end() const;
+
+        // Copies the value into a regular element tree
+        MAZE_API Element to_element() const;
+
+    private:
+        friend class Snapshot;
+        friend class Iterator;
+
+        SnapshotView(const uint8_t* data, size_t size, size_t slot, std::string_view key = std::string_view());
+
+        Element to_element(int depth) const;
+        SnapshotView get_child(size_t index) const;
+        uint32_t read_count() const;
+        uint64_t read_offset() const;
+        std::string_view read_string(uint64_t offset, uint32_t length) const;
+        [[noreturn]] void fail() const;
+
+        const uint8_t* _data = nullptr;
+        size_t _size = 0;
+
+        // Offset of the 16 byte slot describing this value, 0 for a null view
+        size_t _slot = 0;
+        std::string_view _key;
+    };
+
+    class SnapshotView::Iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = SnapshotView;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = SnapshotView;
+
+        MAZE_API inline Iterator(const SnapshotView& parent, size_t index) : _parent(parent), _index(index) {}
+
+        MAZE_API inline SnapshotView operator*() const { return _parent.get_child(_index); }
+        MAZE_API inline Iterator& operator++() { ++_index; return *this; }
+        MAZE_API inline Iterator operator++(int) { Iterator it = *this; ++_index; return it; }
+        MAZE_API inline bool operator==(const Iterator& other) const { return _index == other._index; }
+        MAZE_API inline bool operator!=(const Iterator& other) const { return _index != other._index; }
+
+    private:
+        SnapshotView _parent;
+        size_t _index;
+    };
+
+    inline SnapshotView::Iterator SnapshotView::begin() const { return Iterator(*this, 0); }
+    inline SnapshotView::Iterator SnapshotView::end() const { return Iterator(*this, count_children()); }
+
+    // Binary snapshot of an element tree that is navigated through offsets
+    // instead of being parsed. Snapshots are meant for large, mostly static
+    // documents that are written once and opened often, opening a file maps
+    // it and only checks its header.
+    class Snapshot {
+    public:
+        MAZE_API explicit Snapshot(std::vector<uint8_t> data);
+        MAZE_API Snapshot(Snapshot&& other) noexcept;
+        MAZE_API Snapshot& operator=(Snapshot&& other) noexcept;
+        MAZE_API ~Snapshot();
+
+        MAZE_API static Snapshot open_file(const std::string& path);
+
+        MAZE_API static std::vector<uint8_t> write(const Element& el);
+        MAZE_API static void write_file(const Element& el, const std::string& path);
+
+        MAZE_API inline const uint8_t* data() const { return _data; }
+        MAZE_API inline size_t size() const { return _size; }
+
+        MAZE_API SnapshotView root() const;
+
+    private:
+        Snapshot() = default;
+
+        void check_header() const;
+
+        std::vector<uint8_t> _buffer;
+        std::unique_ptr<MappedFile> _file;
+        const uint8_t* _data = nullptr;
+        size_t _size = 0;
+    };
+
+}  // namespace Maze
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <Maze/DLLSupport.hpp>
+
+namespace Maze {
+
+    // First stage of JSON parsing that finds the structural characters of the
+    // input: brackets, colons, commas and the opening quotes of strings, all
+    // outside of strings. Input is classified 64 bytes at a time, with SSE2 or
+    // AVX2 when the CPU supports it and byte by byte otherwise.
+    //
+    // Long inputs may be scanned in several calls that continue where the
+    // previous one stopped. Every call but the last needs a size divisible by
+    // block_size and positions are relative to the data of each call.
+    class StructuralIndex {
+    public:
+        enum class Implementation {
+            Scalar,
+            Sse2,
+            Avx2
+        };
+
+        MAZE_API explicit StructuralIndex(Implementation implementation = best_implementation());
+
+        MAZE_API static Implementation best_implementation();
+        MAZE_API static bool is_supported(Implementation implementation);
+
+        MAZE_API void scan(const char* data, uint32_t size, std::vector<uint32_t>& positions);
+
+        // True if the input scanned so far ends inside a string
+        MAZE_API inline bool in_string() const { return _in_string != 0; }
+
+        MAZE_API void reset();
+
+        static const uint32_t block_size = 64;
+
+    private:
+        Implementation _implementation;
+
+        // All bits set while inside a string
+        uint64_t _in_string = 0;
+
+        // 1 when the first byte of the next block is escaped
+        uint64_t _escaped = 0;
+    };
+
+}  // namespace Maze
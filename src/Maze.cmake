@@ -2,13 +2,35 @@
 # Set source files that need to be built
 #
 set(MAZE_SOURCES
+    Maze/Cbor.cpp
+    Maze/Document.cpp
     Maze/Element.cpp
     Maze/Helpers.cpp
+    Maze/JsonParser.cpp
+    Maze/JsonPushParser.cpp
+    Maze/JsonSegments.cpp
+    Maze/JsonStream.cpp
+    Maze/JsonWriter.cpp
+    Maze/KeyTable.cpp
+    Maze/MappedFile.cpp
+    Maze/MsgPack.cpp
+    Maze/NdJson.cpp
+    Maze/Snapshot.cpp
+    Maze/SnapshotWriter.cpp
+    Maze/StringScanner.cpp
+    Maze/StructuralIndex.cpp
     Maze/Type.cpp
     Maze/Version.cpp
 )
 set(MAZE_PUBLIC_HEADERS
     ../include/Maze/DLLSupport.hpp
+    ../include/Maze/Document.hpp
+    ../include/Maze/JsonPushParser.hpp
+    ../include/Maze/JsonSegments.hpp
+    ../include/Maze/JsonStream.hpp
     ../include/Maze/Maze.hpp
     ../include/Maze/Helpers.hpp
+    ../include/Maze/NdJson.hpp
+    ../include/Maze/Snapshot.hpp
+    ../include/Maze/StructuralIndex.hpp
 )
@@ -0,0 +1,366 @@
+#include "Cbor.hpp"
+#include "KeyTable.hpp"
+#include <cfloat>
+#include <climits>
+#include <cmath>
+#include <cstring>
+
+namespace Maze {
+
+    namespace {
+
+        const uint8_t indefinite = 31;
+        const uint8_t break_code = 0xff;
+
+    }  // namespace
+
+    CborWriter::CborWriter(std::vector<uint8_t>& output)
+        : _out(output) {}
+
+    void CborWriter::write(const Element& el) {
+        write_value(el);
+    }
+
+    void CborWriter::write_value(const Element& el) {
+        switch (el.get_type()) {
+        case Type::Bool:
+            _out.push_back(el._val_bool ? 0xf5 : 0xf4);
+            break;
+        case Type::Int:
+            if (el._val_int >= 0)
+                write_head(0, (uint64_t)el._val_int);
+            else
+                write_head(1, (uint64_t)(-1 - (int64_t)el._val_int));
+            break;
+        case Type::Double:
+            write_double(el._val_double);
+            break;
+        case Type::String:
+            write_string(el._val_string);
+            break;
+        case Type::Array: {
+            const Element::Children& children = el.get_storage();
+
+            write_head(4, children.values.size());
+            for (const Element& child : children.values) {
+                write_value(child);
+            }
+            break;
+        }
+        case Type::Object: {
+            const Element::Children& children = el.get_storage();
+
+            write_head(5, children.values.size());
+            for (size_t i = 0; i < children.values.size(); ++i) {
+                write_string(KeyTable::get(children.keys[i].id()));
+                write_value(children.values[i]);
+            }
+            break;
+        }
+        default:
+            _out.push_back(0xf6);
+            break;
+        }
+    }
+
+    void CborWriter::write_double(double value) {
+        // Converting a finite double outside the float range is undefined behaviour
+        if (!std::isfinite(value) || std::fabs(value) <= FLT_MAX) {
+            const float narrow = (float)value;
+
+            if ((double)narrow == value) {
+                uint32_t bits;
+                std::memcpy(&bits, &narrow, sizeof(bits));
+
+                _out.push_back(0xfa);
+                write_big_endian(bits, 4);
+                return;
+            }
+        }
+
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+
+        _out.push_back(0xfb);
+        write_big_endian(bits, 8);
+    }
+
+    void CborWriter::write_string(std::string_view value) {
+        write_head(3, value.size());
+        _out.insert(_out.end(), value.begin(), value.end());
+    }
+
+    void CborWriter::write_head(uint8_t major_type, uint64_t argument) {
+        const uint8_t type = major_type << 5;
+
+        if (argument < 24) {
+            _out.push_back(type | (uint8_t)argument);
+        }
+        else if (argument <= UINT8_MAX) {
+            _out.push_back(type | 24);
+            write_big_endian(argument, 1);
+        }
+        else if (argument <= UINT16_MAX) {
+            _out.push_back(type | 25);
+            write_big_endian(argument, 2);
+        }
+        else if (argument <= UINT32_MAX) {
+            _out.push_back(type | 26);
+            write_big_endian(argument, 4);
+        }
+        else {
+            _out.push_back(type | 27);
+            write_big_endian(argument, 8);
+        }
+    }
+
+    void CborWriter::write_big_endian(uint64_t value, int bytes) {
+        for (int shift = (bytes - 1) * 8; shift >= 0; shift -= 8) {
+            _out.push_back((uint8_t)(value >> shift));
+        }
+    }
+
+
+    CborReader::CborReader(const uint8_t* begin, const uint8_t* end)
+        : _begin(begin), _pos(begin), _end(end) {}
+
+    Element CborReader::read() {
+        Element result;
+        read_value(result, 0);
+
+        if (_pos != _end)
+            fail("Unexpected trailing bytes");
+
+        return result;
+    }
+
+    void CborReader::read_value(Element& target, int depth) {
+        if (_pos == _end)
+            fail("Unexpected end of input");
+
+        const uint8_t major_type = *_pos >> 5;
+        const uint8_t additional = *_pos & 0x1f;
+        ++_pos;
+
+        switch (major_type) {
+        case 0: {
+            const uint64_t value = read_argument(additional);
+
+            if (value <= INT_MAX)
+                target.set_int((int)value);
+            else
+                target.set_double((double)value);
+            break;
+        }
+        case 1: {
+            const uint64_t value = read_argument(additional);
+
+            if (value <= INT_MAX)
+                target.set_int(-1 - (int)value);
+            else
+                target.set_double(-1.0 - (double)value);
+            break;
+        }
+        case 2:
+        case 3:
+            read_string(target.set_empty_string(std::pmr::get_default_resource()), major_type, additional);
+            break;
+        case 4:
+            read_array(target, additional, depth + 1);
+            break;
+        case 5:
+            read_object(target, additional, depth + 1);
+            break;
+        case 6:
+            // Tags only add meaning to the value that follows
+            if (depth >= max_depth)
+                fail("Maximum nesting depth exceeded");
+
+            read_argument(additional);
+            read_value(target, depth + 1);
+            break;
+        default:
+            switch (additional) {
+            case 20:
+                target.set_bool(false);
+                break;
+            case 21:
+                target.set_bool(true);
+                break;
+            case 22:
+            case 23:
+                target.set_as_null();
+                break;
+            case 25:
+            case 26:
+            case 27:
+                target.set_double(read_float(additional));
+                break;
+            default:
+                --_pos;
+                fail("Unsupported simple value " + std::to_string(additional));
+            }
+        }
+    }
+
+    void CborReader::read_array(Element& target, uint8_t additional, int depth) {
+        if (depth > max_depth)
+            fail("Maximum nesting depth exceeded");
+
+        target.set_container(Type::Array, std::pmr::get_default_resource());
+        Element::Children& children = *target._val_children;
+
+        if (additional == indefinite) {
+            while (!read_break()) {
+                children.values.emplace_back();
+                read_value(children.values.back(), depth);
+            }
+            return;
+        }
+
+        const uint64_t size = read_argument(additional);
+
+        // Every value takes at least a byte, do not trust larger sizes
+        children.values.reserve(std::min<uint64_t>(size, _end - _pos));
+
+        for (uint64_t i = 0; i < size; ++i) {
+            children.values.emplace_back();
+            read_value(children.values.back(), depth);
+        }
+    }
+
+    void CborReader::read_object(Element& target, uint8_t additional, int depth) {
+        if (depth > max_depth)
+            fail("Maximum nesting depth exceeded");
+
+        target.set_container(Type::Object, std::pmr::get_default_resource());
+        Element::Children& children = *target._val_children;
+
+        uint64_t size = UINT64_MAX;
+        if (additional != indefinite) {
+            size = read_argument(additional);
+
+            children.values.reserve(std::min<uint64_t>(size, (_end - _pos) / 2));
+            children.keys.reserve(children.values.capacity());
+        }
+
+        std::pmr::string key;
+        for (uint64_t i = 0; i < size; ++i) {
+            if (additional == indefinite && read_break())
+                break;
+
+            if (_pos == _end)
+                fail("Unexpected end of input");
+            if ((*_pos >> 5) != 3)
+                fail("Map keys must be text strings");
+
+            const uint8_t key_additional = *_pos++ & 0x1f;
+            key.clear();
+            read_string(key, 3, key_additional);
+
+            children.values.emplace_back();
+            Element& child = children.values.back();
+            child._key = KeyTable::intern(key);
+            children.add_key(child._key);
+
+            read_value(child, depth);
+        }
+
+        // Duplicate keys keep the last value, same as set()
+        children.remove_duplicate_keys();
+    }
+
+    void CborReader::read_string(std::pmr::string& target, uint8_t major_type, uint8_t additional) {
+        if (additional == indefinite) {
+            // Indefinite strings are a sequence of definite chunks of the same type
+            while (!read_break()) {
+                if (_pos == _end)
+                    fail("Unexpected end of input");
+                if ((*_pos >> 5) != major_type || (*_pos & 0x1f) == indefinite)
+                    fail("Invalid indefinite length string chunk");
+
+                read_string(target, major_type, *_pos++ & 0x1f);
+            }
+            return;
+        }
+
+        const uint64_t size = read_argument(additional);
+        if ((uint64_t)(_end - _pos) < size)
+            fail("Unexpected end of input");
+
+        target.append((const char*)_pos, size);
+        _pos += size;
+    }
+
+    double CborReader::read_float(uint8_t additional) {
+        if (additional == 25) {
+            const uint16_t half = (uint16_t)read_big_endian(2);
+            const int exponent = (half >> 10) & 0x1f;
+            const int mantissa = half & 0x3ff;
+
+            double value;
+            if (exponent == 0)
+                value = std::ldexp(mantissa, -24);
+            else if (exponent != 31)
+                value = std::ldexp(mantissa + 1024, exponent - 25);
+            else
+                value = mantissa == 0 ? INFINITY : NAN;
+
+            return (half & 0x8000) ? -value : value;
+        }
+
+        if (additional == 26) {
+            const uint32_t bits = (uint32_t)read_big_endian(4);
+            float value;
+            std::memcpy(&value, &bits, sizeof(value));
+
+            return value;
+        }
+
+        const uint64_t bits = read_big_endian(8);
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+
+        return value;
+    }
+
+    uint64_t CborReader::read_argument(uint8_t additional) {
+        if (additional < 24)
+            return additional;
+
+        if (additional > 27) {
+            --_pos;
+            fail(additional == indefinite ? "Unexpected indefinite length" : "Invalid additional information");
+        }
+
+        return read_big_endian(1 << (additional - 24));
+    }
+
+    uint64_t CborReader::read_big_endian(int bytes) {
+        if (_end - _pos < bytes)
+            fail("Unexpected end of input");
+
+        uint64_t value = 0;
+        for (int i = 0; i < bytes; ++i) {
+            value = (value << 8) | *_pos++;
+        }
+
+        return value;
+    }
+
+    bool CborReader::read_break() {
+        if (_pos == _end)
+            fail("Unexpected end of input");
+
+        if (*_pos != break_code)
+            return false;
+
+        ++_pos;
+        return true;
+    }
+
+    void CborReader::fail(const std::string& message) const {
+        throw MazeException("Unable to read CBOR: " + message + " at offset " + std::to_string(_pos - _begin));
+    }
+
+}  // namespace Maze
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <Maze/Maze.hpp>
+
+namespace Maze {
+
+    // Encodes Element trees as CBOR (RFC 8949) using definite lengths and the
+    // shortest integer arguments. Doubles are stored as single precision when
+    // that is lossless. Functions are written as null, same as in JSON.
+    class CborWriter {
+    public:
+        explicit CborWriter(std::vector<uint8_t>& output);
+
+        void write(const Element& el);
+
+    private:
+        void write_value(const Element& el);
+        void write_double(double value);
+        void write_string(std::string_view value);
+        void write_head(uint8_t major_type, uint64_t argument);
+        void write_big_endian(uint64_t value, int bytes);
+
+        std::vector<uint8_t>& _out;
+    };
+
+    // Decodes CBOR into Element trees. Indefinite lengths and half precision
+    // floats are supported, tags are skipped, integers outside the int range
+    // become doubles, byte strings become strings and undefined becomes null.
+    // Map keys have to be text strings.
+    class CborReader {
+    public:
+        CborReader(const uint8_t* begin, const uint8_t* end);
+
+        Element read();
+
+        static const int max_depth = 1024;
+
+    private:
+        void read_value(Element& target, int depth);
+        void read_array(Element& target, uint8_t additional, int depth);
+        void read_object(Element& target, uint8_t additional, int depth);
+        void read_string(std::pmr::string& target, uint8_t major_type, uint8_t additional);
+        double read_float(uint8_t additional);
+        uint64_t read_argument(uint8_t additional);
+        uint64_t read_big_endian(int bytes);
+        bool read_break();
+
+        [[noreturn]] void fail(const std::string& message) const;
+
+        const uint8_t* _begin;
+        const uint8_t* _pos;
+        const uint8_t* _end;
+    };
+
+}  // namespace Maze
@@ -0,0 +1,40 @@
+#include <Maze/Document.hpp>
+
+namespace Maze {
+
+    Document::Document(size_t initial_size, std::pmr::memory_resource* upstream)
+        : _arena(initial_size, upstream) {}
+
+    Element& Document::parse(std::string_view json_string) {
+        _root = Element::from_json(json_string, &_arena);
+
+        return _root;
+    }
+
+    Element& Document::parse_file(const std::string& path) {
+        _root = Element::from_json_file(path, &_arena);
+
+        return _root;
+    }
+
+    Element& Document::set_root(Type type) {
+        _root = Element(type, &_arena);
+
+        return _root;
+    }
+
+    Element Document::create(Type type) {
+        return Element(type, &_arena);
+    }
+
+    void Document::reset() {
+        // A tree that lives entirely in the arena goes away with it
+        if (!_arena.holds_external() && _root.get_resource() == &_arena)
+            _root.forget_value();
+        else
+            _root.set_as_null();
+
+        _arena.release();
+    }
+
+}  // namespace Maze
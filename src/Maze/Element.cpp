@@ -1,10 +1,33 @@
 #include <Maze/Maze.hpp>
-#include <Maze/Helpers.hpp>
-#include <nlohmann/json.hpp>
+#include <Maze/Document.hpp>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string_view>
+#include "Cbor.hpp"
+#include "JsonParser.hpp"
+#include "JsonWriter.hpp"
+#include "KeyTable.hpp"
+#include "MappedFile.hpp"
+#include "MsgPack.hpp"
 
 namespace Maze {
 
+    Element::Element(Type val, std::pmr::memory_resource* resource) {
+        if (val == Type::Array || val == Type::Object)
+            set_container(val, resource);
+        else
+            set_type(val);
+    }
+
     void Element::copy_from_element(const Element& val) {
+        copy_from_element(val, get_resource());
+    }
+
+    void Element::copy_from_element(const Element& val, std::pmr::memory_resource* resource) {
+        if (&val == this)
+            return;
+
         switch (val.get_type()) {
         case Type::Bool:
             set_bool(val.get_bool());
@@ -15,15 +38,37 @@ namespace Maze {
         case Type::Double:
             set_double(val.get_double());
             break;
-        case Type::String:
-            set_string(val.get_string());
+        case Type::String: {
+            if (_type == Type::String) {
+                _val_string = val._val_string;
+                break;
+            }
+
+            // val may live inside one of our own children, copy it before releasing them
+            std::pmr::string copy(val._val_string, resource);
+            reset_value();
+            new (&_val_string) std::pmr::string(std::move(copy));
+            _type = Type::String;
             break;
+        }
         case Type::Array:
-            set_array(val.get_children());
-            break;
-        case Type::Object:
-            set_object(val.get_keys(), val.get_children());
+        case Type::Object: {
+            Children* children = val._val_children;
+            const Type type = val._type;
+
+            // Share the children until one side modifies them. Copies into another
+            // resource are deep, so they do not depend on memory they do not own.
+            if (children->get_resource() == resource && !children->borrowed)
+                children->ref_count.fetch_add(1, std::memory_order_relaxed);
+            else
+                children = children->clone(resource);
+
+            // Released only now, val may be one of our own children
+            reset_value();
+            _val_children = children;
+            _type = type;
             break;
+        }
         case Type::Function:
             set_function(val.get_callback());
             break;
@@ -58,19 +103,409 @@ namespace Maze {
         }
     }
 
-    void Element::set_as_null(bool clear_existing_values) {
+    void Element::set_as_null(bool) {
+        // The value union only ever holds the active type, so there is nothing
+        // left to keep around once the type changes to null.
+        reset_value();
+        _type = Type::Null;
+    }
+
+    void Element::release_value() {
+        switch (_type) {
+        case Type::String:
+            _val_string.~basic_string();
+            break;
+        case Type::Array:
+        case Type::Object:
+            Children::release(_val_children);
+            break;
+        default:
+            break;
+        }
+
         _type = Type::Null;
+    }
+
+    void Element::take_value(Element& val) noexcept {
+        switch (val._type) {
+        case Type::Bool:
+            _val_bool = val._val_bool;
+            break;
+        case Type::Int:
+            _val_int = val._val_int;
+            break;
+        case Type::Double:
+            _val_double = val._val_double;
+            break;
+        case Type::String:
+            new (&_val_string) std::pmr::string(std::move(val._val_string));
+            val._val_string.~basic_string();
+            break;
+        case Type::Array:
+        case Type::Object:
+            _val_children = val._val_children;
+            break;
+        case Type::Function:
+            _callback = val._callback;
+            break;
+        default:
+            break;
+        }
+
+        _type = val._type;
+        val._type = Type::Null;
+    }
 
-        if (clear_existing_values) {
-            _val_bool = false;
-            _val_int = 0;
-            _val_double = 0;
-            _val_string = "";
-            _children.clear();
-            _children_keys.clear();
+    void Element::steal_value(Element& val) noexcept {
+        if (&val == this)
+            return;
+
+        // val may live inside one of our own children, detach it before releasing them
+        Element taken;
+        taken.take_value(val);
+
+        reset_value();
+        take_value(taken);
+    }
+
+    void Element::set_key(std::string_view key) {
+        _key = KeyTable::intern(key);
+    }
+
+    const std::string& Element::get_key() const {
+        return KeyTable::get(_key.id());
+    }
+
+    void Element::set_container(Type type, std::pmr::memory_resource* resource) {
+        Children* children = Children::create(resource);
+
+        reset_value();
+        _val_children = children;
+        _type = type;
+    }
+
+    std::pmr::string& Element::set_empty_string(std::pmr::memory_resource* resource) {
+        reset_value();
+        new (&_val_string) std::pmr::string(resource);
+        _type = Type::String;
+
+        return _val_string;
+    }
+
+    void Element::move_to_resource(std::pmr::memory_resource* resource) {
+        if (_type == Type::String && _val_string.get_allocator().resource() != resource) {
+            std::pmr::string moved(_val_string, resource);
+            _val_string.~basic_string();
+            new (&_val_string) std::pmr::string(std::move(moved));
+
+            return;
+        }
+
+        if (!is_container() || _val_children->get_resource() == resource)
+            return;
+
+        if (_val_children->is_shared()) {
+            Children* children = _val_children->clone(resource);
+            Children::release(_val_children);
+            _val_children = children;
+
+            return;
+        }
+
+        _val_children->materialize();
+
+        std::unique_ptr<Children, Children::Deleter> children(Children::create(resource));
+        Children& source = *_val_children;
+
+        children->keys.reserve(source.keys.size());
+        for (const Key& key : source.keys)
+            children->add_key(key);
+        children->values.reserve(source.values.size());
+        for (Element& child : source.values) {
+            Element& moved = children->values.emplace_back(std::move(child));
+            moved.move_to_resource(resource);
+        }
+
+        Children::release(_val_children);
+        _val_children = children.release();
+    }
+
+    Element::Children& Element::detach_children() {
+        _val_children->materialize();
+
+        if (_val_children->is_shared()) {
+            Children* children = _val_children->clone(_val_children->get_resource());
+            Children::release(_val_children);
+            _val_children = children;
+        }
+
+        _val_children->reset_json_size();
+        return *_val_children;
+    }
+
+    Element::Children& Element::borrow_children() {
+        Children& children = detach_children();
+
+        // Whatever is written through the reference is allocated without knowing
+        // about the resource of this container
+        if (!children.borrowed) {
+            children.borrowed = true;
+            children.mark_external();
         }
+
+        return children;
     }
 
+    std::pmr::memory_resource* Element::get_resource() const {
+        if (is_container())
+            return _val_children->get_resource();
+
+        if (_type == Type::String)
+            return _val_string.get_allocator().resource();
+
+        return std::pmr::get_default_resource();
+    }
+
+#pragma region Children
+
+    // Open addressing hash table over the key ids of an object
+    struct Element::KeyIndex {
+        struct Slot {
+            uint32_t key_id;
+            uint32_t position;  // Child index + 1, 0 marks an empty slot
+        };
+
+        std::vector<Slot> slots;
+        size_t count = 0;
+
+        explicit KeyIndex(size_t capacity) {
+            size_t slot_count = 16;
+            while (slot_count < capacity * 2)
+                slot_count *= 2;
+
+            slots.resize(slot_count, Slot{ 0, 0 });
+        }
+
+        static uint32_t hash(uint32_t key_id) {
+            // Keys of one object often have neighbouring ids, spread them over the table
+            key_id ^= key_id >> 16;
+            key_id *= 0x45D9F3B;
+            key_id ^= key_id >> 16;
+
+            return key_id;
+        }
+
+        bool has_room() const {
+            return (count + 1) * 2 <= slots.size();
+        }
+
+        // Returns -1 when the key was added, the existing position otherwise
+        int insert(const std::pmr::vector<Key>& keys, size_t index) {
+            const uint32_t key_id = keys[index].id();
+            const size_t mask = slots.size() - 1;
+
+            for (size_t i = hash(key_id) & mask;; i = (i + 1) & mask) {
+                Slot& slot = slots[i];
+
+                if (slot.position == 0) {
+                    slot = Slot{ key_id, (uint32_t)index + 1 };
+                    ++count;
+                    return -1;
+                }
+
+                if (slot.key_id == key_id)
+                    return (int)slot.position - 1;
+            }
+        }
+
+        int find(uint32_t key_id) const {
+            const size_t mask = slots.size() - 1;
+
+            for (size_t i = hash(key_id) & mask;; i = (i + 1) & mask) {
+                const Slot& slot = slots[i];
+
+                if (slot.position == 0)
+                    return -1;
+
+                if (slot.key_id == key_id)
+                    return (int)slot.position - 1;
+            }
+        }
+    };
+
+    Element::Children* Element::Children::create(std::pmr::memory_resource* resource) {
+        void* memory = resource->allocate(sizeof(Children), alignof(Children));
+
+        return new (memory) Children(resource);
+    }
+
+    void Element::Children::destroy(Children* children) noexcept {
+        std::pmr::memory_resource* resource = children->get_resource();
+
+        children->~Children();
+        resource->deallocate(children, sizeof(Children), alignof(Children));
+    }
+
+    void Element::Children::release(Children* children) noexcept {
+        if (children->ref_count.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            destroy(children);
+    }
+
+    Element::Children* Element::Children::clone(std::pmr::memory_resource* resource) const {
+        materialize();
+
+        std::unique_ptr<Children, Deleter> children(create(resource));
+
+        // Container children are shared in turn, so this only copies one level and
+        // the nested children that were borrowed
+        children->keys.reserve(keys.size());
+        for (const Key& key : keys)
+            children->add_key(key);
+        children->values.reserve(values.size());
+        for (const Element& child : values) {
+            Element& copy = children->values.emplace_back();
+            copy.copy_from_element(child, resource);
+            copy._key = child._key;
+        }
+
+        return children.release();
+    }
+
+    Element::Children::~Children() {
+        delete key_index.load(std::memory_order_relaxed);
+        delete key_strings.load(std::memory_order_relaxed);
+        delete lazy.load(std::memory_order_relaxed);
+        delete json_size.load(std::memory_order_relaxed);
+    }
+
+    void Element::Children::mark_external() const {
+        std::pmr::memory_resource* resource = get_resource();
+
+        if (resource == std::pmr::new_delete_resource())
+            return;
+
+        if (Document::Arena* arena = dynamic_cast<Document::Arena*>(resource))
+            arena->mark_external();
+    }
+
+    int Element::Children::find_key(uint32_t key_id) const {
+        if (keys.size() < object_key_index_threshold) {
+            for (int i = (int)keys.size() - 1; i >= 0; --i) {
+                if (keys[i].id() == key_id)
+                    return i;
+            }
+
+            return -1;
+        }
+
+        KeyIndex* index = key_index.load(std::memory_order_acquire);
+
+        if (index == nullptr) {
+            std::unique_ptr<KeyIndex> built = std::make_unique<KeyIndex>(keys.size());
+            for (size_t i = 0; i < keys.size(); ++i)
+                built->insert(keys, i);
+
+            // Another reader may have published an identical index in the meantime
+            if (key_index.compare_exchange_strong(index, built.get(), std::memory_order_acq_rel)) {
+                index = built.release();
+                mark_external();
+            }
+        }
+
+        return index->find(key_id);
+    }
+
+    void Element::Children::key_appended() {
+        KeyIndex* index = key_index.load(std::memory_order_relaxed);
+
+        if (index == nullptr)
+            return;
+
+        if (index->has_room())
+            index->insert(keys, keys.size() - 1);
+        else
+            reset_key_index();
+    }
+
+    void Element::Children::parse_lazy() const {
+        JsonParser::parse_lazy_children(*this);
+    }
+
+    void Element::Children::reset_key_index() {
+        delete key_index.exchange(nullptr, std::memory_order_relaxed);
+    }
+
+    const std::vector<std::string>& Element::Children::get_key_strings() const {
+        std::vector<std::string>* cached = key_strings.load(std::memory_order_acquire);
+
+        if (cached == nullptr) {
+            std::unique_ptr<std::vector<std::string>> built = std::make_unique<std::vector<std::string>>();
+            built->reserve(values.size());
+
+            if (keys.size() == values.size()) {
+                for (const Key& key : keys)
+                    built->push_back(KeyTable::get(key.id()));
+            }
+            else {
+                for (size_t i = 0; i < values.size(); ++i)
+                    built->push_back(array_index_prefix_char + std::to_string(i));
+            }
+
+            // Another reader may have published identical keys in the meantime
+            if (key_strings.compare_exchange_strong(cached, built.get(), std::memory_order_acq_rel)) {
+                cached = built.release();
+                mark_external();
+            }
+        }
+
+        return *cached;
+    }
+
+    void Element::Children::reset_key_strings() {
+        delete key_strings.exchange(nullptr, std::memory_order_relaxed);
+    }
+
+    void Element::Children::reset_json_size() {
+        if (json_size.load(std::memory_order_relaxed) != nullptr)
+            delete json_size.exchange(nullptr, std::memory_order_relaxed);
+    }
+
+    void Element::Children::renumber_index_keys(size_t from_index) {
+        for (size_t i = from_index; i < keys.size(); ++i) {
+            const std::string& key = KeyTable::get(keys[i].id());
+
+            if (key.length() > 0 && key[0] == array_index_prefix_char) {
+                Key new_key = KeyTable::intern(array_index_prefix_char + std::to_string(i));
+
+                if (keys[i].id() != new_key.id()) {
+                    set_key(i, new_key);
+                    values[i]._key = std::move(new_key);
+                }
+            }
+        }
+
+        reset_key_index();
+        reset_key_strings();
+    }
+
+    void Element::Children::erase(size_t index) {
+        // Shift by moving so every child keeps the key stored for its position
+        for (size_t i = index + 1; i < values.size(); ++i) {
+            values[i - 1].steal_value(values[i]);
+            values[i - 1]._key = std::move(values[i]._key);
+        }
+
+        values.pop_back();
+        if (!keys.empty())
+            keys.erase(keys.begin() + index);
+
+        reset_key_index();
+        reset_key_strings();
+    }
+
+#pragma endregion
+
+
 #pragma region Boolean
 
     bool Element::get_bool(bool fallback_value) const {
@@ -130,27 +565,41 @@ namespace Maze {
 
 #pragma region String
 
-    const std::string& Element::get_string() const {
-        static const std::string empty_string_constant = "";
-
-        return get_string_const_ref(empty_string_constant);
-    }
-
-    const std::string& Element::get_string_const_ref(const std::string& fallback_value) const {
+    std::string_view Element::get_string(std::string_view fallback_value) const {
         if (_type == Type::String)
             return _val_string;
 
         return fallback_value;
     }
 
-    std::string Element::get_string(const std::string& fallback_value) const {
+    const std::pmr::string& Element::get_string_const_ref(const std::pmr::string& fallback_value) const {
         if (_type == Type::String)
             return _val_string;
 
         return fallback_value;
     }
 
-    std::string& Element::get_string_ref() {
+    void Element::set_string(std::string_view val) {
+        if (_type == Type::String) {
+            _val_string.assign(val.data(), val.size());
+            return;
+        }
+
+        // val may live inside one of our own children, copy it before releasing them
+        std::pmr::string copy(val);
+        reset_value();
+        new (&_val_string) std::pmr::string(std::move(copy));
+        _type = Type::String;
+    }
+
+    void Element::set_string(std::pmr::string&& val) {
+        std::pmr::string taken(std::move(val));
+        reset_value();
+        new (&_val_string) std::pmr::string(std::move(taken));
+        _type = Type::String;
+    }
+
+    std::pmr::string& Element::get_string_ref() {
         if (_type != Type::String)
             throw MazeException("Cannot get reference to string value from a non-string element. Use set_string instead to set value and change type.");
 
@@ -168,84 +617,177 @@ namespace Maze {
     }
 
     const Element& Element::get_const_ref(int index, const Element& fallback_value) const {
-        if ((_type == Type::Array || _type == Type::Object) && index < _children.size())
-            return _children[index];
+        if (is_container() && index >= 0 && index < get_storage().values.size())
+            return _val_children->values[index];
 
         return fallback_value;
     }
 
     Element Element::get(int index, const Element& fallback_value) const {
-        if ((_type == Type::Array || _type == Type::Object) && index < _children.size())
-            return _children[index];
+        if (is_container() && index >= 0 && index < get_storage().values.size())
+            return _val_children->values[index];
 
         return fallback_value;
     }
 
     Element* Element::get_ptr(int index) {
-        if (_type != Type::Array && _type != Type::Object)
+        if (!is_container())
             throw MazeException("Cannot access array value by index on non-array or non-object element.");
 
-        if (index >= _children.size())
+        if (index < 0 || index >= get_storage().values.size())
             throw MazeException("Array index out of range.");
 
-        return &_children[index];
+        return &borrow_children().values[index];
     }
 
 
     void Element::set_array(const std::vector<Element>& val) {
+        std::pmr::memory_resource* resource = get_resource();
+        std::unique_ptr<Children, Children::Deleter> children(Children::create(resource));
+
+        children->values.reserve(val.size());
+        for (const Element& child : val) {
+            children->values.emplace_back().copy_from_element(child, resource);
+        }
+
+        reset_value();
+        _val_children = children.release();
         _type = Type::Array;
-        _children.clear();
-        _children_keys.clear();
+    }
 
-        _children = val;
+    void Element::set_array(std::vector<Element>&& val) {
+        std::pmr::memory_resource* resource = get_resource();
+        std::unique_ptr<Children, Children::Deleter> children(Children::create(resource));
 
-        _children_keys.reserve(val.size());
-        for (int i = 0; i < val.size(); ++i) {
-            const std::string child_key = array_index_prefix_char + std::to_string(_children_keys.size());
+        children->values.reserve(val.size());
+        for (Element& child : val) {
+            Element& moved = children->values.emplace_back(std::move(child));
 
-            _children[i].set_key(child_key);
-            _children_keys.push_back(child_key);
+            // Array children have no keys, drop any left over from where they came from
+            moved._key = Key();
+            moved.move_to_resource(resource);
         }
+
+        reset_value();
+        _val_children = children.release();
+        _type = Type::Array;
     }
 
-    Element& Element::push_back(const Element& value) {
-        if (_type != Type::Array && _type != Type::Object)
+    Element& Element::push_back(Element&& value) {
+        if (!is_container())
             throw MazeException("Unable push_back element into non-array or non-object type");
 
-        const std::string child_key = array_index_prefix_char + std::to_string(_children_keys.size());
+        // value may be one of our own children, move it out before the vector grows
+        Element child(std::move(value));
+        Children& children = detach_children();
+        child.move_to_resource(children.get_resource());
+
+        if (_type == Type::Array) {
+            child._key = Key();
+            children.values.push_back(std::move(child));
+            children.reset_key_strings();
 
-        if (exists(child_key))
+            return *this;
+        }
+
+        const std::string child_key = array_index_prefix_char + std::to_string(children.keys.size());
+        Key key = KeyTable::intern(child_key);
+
+        if (children.find_key(key.id()) != -1)
             throw MazeException("Unable to determine element index. Values map already contains an element with key " + child_key);
 
-        Element value_copy = value;
-        value_copy.set_key(child_key);
-        _children_keys.push_back(child_key);
-        _children.push_back(value_copy);
+        children.add_key(key);
+        child._key = std::move(key);
+        children.values.push_back(std::move(child));
+        children.key_appended();
+        children.reset_key_strings();
 
         return *this;
     }
 
+    void Element::reserve(size_t capacity) {
+        if (!is_container())
+            throw MazeException("Unable to reserve children in non-array or non-object type");
+
+        Children& children = detach_children();
+
+        if (_type == Type::Object)
+            children.keys.reserve(capacity);
+        children.values.reserve(capacity);
+    }
+
+    void Element::shrink_to_fit() {
+        if (is_container()) {
+            Children& children = detach_children();
+
+            children.keys.shrink_to_fit();
+            children.values.shrink_to_fit();
+        }
+    }
+
 
     void Element::remove_at(int index, bool update_string_indexes) {
-        if (index >= _children.size())
+        if (!is_container() || index < 0 || index >= get_storage().values.size())
             throw MazeException("Array index out of range.");
 
-        _children.erase(_children.begin() + index);
-        _children_keys.erase(_children_keys.begin() + index);
+        Children& children = detach_children();
+        children.erase(index);
 
-        if (update_string_indexes) {
-            for (int i = (int)_children_keys.size() - 1; i > index; --i) {
-                const std::string& key = _children_keys[i];
+        // Array keys are generated from positions, only objects store "~N" keys that need renumbering
+        if (_type == Type::Object && update_string_indexes)
+            children.renumber_index_keys(index);
+    }
 
-                if (key.length() > 0 && key[0] == array_index_prefix_char) {
-                    const std::string new_key = array_index_prefix_char + std::to_string(i);
+    Element Element::take(int index) {
+        if (!is_container() || index < 0 || index >= get_storage().values.size())
+            throw MazeException("Array index out of range.");
 
-                    if (key != new_key) {
-                        _children_keys[i] = new_key;
-                    }
-                }
-            }
+        Children& children = detach_children();
+        Element taken(std::move(children.values[index]));
+        Key taken_key = std::move(children.values[index]._key);
+        children.erase(index);
+
+        return Element(std::move(taken), std::move(taken_key));
+    }
+
+    void Element::remove_all_children() {
+        if (!is_container())
+            return;
+
+        // Nothing to keep from shared or unparsed children, start over with empty ones
+        if (_val_children->is_shared() || _val_children->is_lazy()) {
+            set_container(_type, get_resource());
+            return;
         }
+
+        _val_children->values.clear();
+        _val_children->keys.clear();
+        _val_children->reset_key_index();
+        _val_children->reset_key_strings();
+        _val_children->reset_json_size();
+    }
+
+    const Element::ChildVector& Element::get_children() const {
+        static const ChildVector empty_children_constant;
+
+        if (is_container())
+            return get_storage().values;
+
+        return empty_children_constant;
+    }
+
+    Element::ChildVector::iterator Element::begin() {
+        if (is_container())
+            return borrow_children().values.begin();
+
+        return ChildVector::iterator();
+    }
+
+    Element::ChildVector::iterator Element::end() {
+        if (is_container())
+            return borrow_children().values.end();
+
+        return ChildVector::iterator();
     }
 
 #pragma endregion
@@ -253,48 +795,45 @@ namespace Maze {
 
 #pragma region Object
 
-    const Element& Element::get(const std::string& key) const {
+    const Element& Element::get(std::string_view key) const {
         static const Element empty_element_constant = Element();
 
         return get_const_ref(key, empty_element_constant);
     }
 
-    const Element& Element::get_const_ref(const std::string& key, const Element& fallback_value) const {
+    const Element& Element::get_const_ref(std::string_view key, const Element& fallback_value) const {
         if (_type == Type::Object) {
             int value_index = index_of(key);
 
             if (value_index != -1) {
-                return _children[value_index];
+                return _val_children->values[value_index];
             }
         }
 
         return fallback_value;
     }
 
-    Element Element::get(const std::string& key, const Element& fallback_value) const {
+    Element Element::get(std::string_view key, const Element& fallback_value) const {
         if (_type == Type::Object) {
             int value_index = index_of(key);
 
             if (value_index != -1)
-                return _children[value_index];
+                return _val_children->values[value_index];
         }
 
         return fallback_value;
     }
 
-    Element* Element::get_ptr(const std::string& key) {
+    Element* Element::get_ptr(std::string_view key) {
         if (_type != Type::Object)
             throw MazeException("Cannot access object value by key on non-object element.");
 
         int value_index = index_of(key);
 
-        if (value_index == -1) {
-            set(key, Element(Type::Null));
-
-            value_index = index_of(key);
-        }
+        if (value_index == -1)
+            value_index = (int)set_value(key, Element(Type::Null));
 
-        return &_children[value_index];
+        return &borrow_children().values[value_index];
     }
 
 
@@ -302,83 +841,274 @@ namespace Maze {
         if (keys.size() != values.size())
             throw MazeException("Keys and values do not have the same size.");
 
+        // Copy before releasing the old children, keys may be our own
+        std::pmr::memory_resource* resource = get_resource();
+        std::unique_ptr<Children, Children::Deleter> children(Children::create(resource));
+        children->keys.reserve(keys.size());
+        children->values.reserve(values.size());
+        for (size_t i = 0; i < values.size(); ++i) {
+            Element& copy = children->values.emplace_back();
+            copy.copy_from_element(values[i], resource);
+            copy._key = KeyTable::intern(keys[i]);
+            children->add_key(copy._key);
+        }
+
+        reset_value();
+        _val_children = children.release();
         _type = Type::Object;
-        _children.clear();
-        _children_keys.clear();
+    }
 
-        _children = values;
-        _children_keys = keys;
+    void Element::set_object(std::vector<std::string>&& keys, std::vector<Element>&& values) {
+        if (keys.size() != values.size())
+            throw MazeException("Keys and values do not have the same size.");
 
-        for (int i = 0; i < _children_keys.size(); ++i) {
-            _children[i].set_key(_children_keys[i]);
+        std::pmr::memory_resource* resource = get_resource();
+        std::unique_ptr<Children, Children::Deleter> children(Children::create(resource));
+        children->keys.reserve(keys.size());
+        children->values.reserve(values.size());
+        for (size_t i = 0; i < values.size(); ++i) {
+            Element& moved = children->values.emplace_back(std::move(values[i]));
+            moved._key = KeyTable::intern(keys[i]);
+            children->add_key(moved._key);
+            moved.move_to_resource(resource);
         }
+
+        reset_value();
+        _val_children = children.release();
+        _type = Type::Object;
     }
 
-    void Element::set(const std::string& key, const Element& value) {
+    size_t Element::set_value(std::string_view key, Element&& value) {
         if (_type != Type::Object)
             throw MazeException("Cannot set element into non-object type.");
 
-        int value_index = index_of(key);
-        Element value_copy = value;
-        value_copy.set_key(key);
+        Children& children = detach_children();
+        Key interned_key = KeyTable::intern(key);
+        const int value_index = children.find_key(interned_key.id());
 
         if (value_index != -1) {
-            _children[value_index] = value_copy;
+            children.values[value_index] = std::move(value);
+            children.values[value_index].move_to_resource(children.get_resource());
+
+            return value_index;
+        }
+
+        // value may be one of our own children, move it out before the vector grows
+        Element child(std::move(value));
+        child.move_to_resource(children.get_resource());
+        children.add_key(interned_key);
+        child._key = std::move(interned_key);
+        children.values.push_back(std::move(child));
+        children.key_appended();
+        children.reset_key_strings();
+
+        return children.values.size() - 1;
+    }
+
+
+    void Element::set_many(const std::vector<std::string>& keys, const std::vector<Element>& values, bool keys_are_unique) {
+        set_many(std::vector<std::string>(keys), std::vector<Element>(values), keys_are_unique);
+    }
+
+    void Element::set_many(std::vector<std::string>&& keys, std::vector<Element>&& values, bool keys_are_unique) {
+        if (_type != Type::Object)
+            throw MazeException("Cannot set elements into non-object type.");
+
+        if (keys.size() != values.size())
+            throw MazeException("Keys and values do not have the same size.");
+
+        Children& children = detach_children();
+        const bool check_duplicates = !keys_are_unique || !children.keys.empty();
+
+        children.reset_key_index();
+        children.reset_key_strings();
+
+        children.keys.reserve(children.keys.size() + keys.size());
+        children.values.reserve(children.values.size() + values.size());
+
+        for (size_t i = 0; i < keys.size(); ++i) {
+            values[i].move_to_resource(children.get_resource());
+            values[i]._key = KeyTable::intern(keys[i]);
+            children.add_key(values[i]._key);
+            children.values.push_back(std::move(values[i]));
+        }
+
+        if (check_duplicates)
+            children.remove_duplicate_keys();
+    }
+
+    void Element::Children::remove_duplicate_keys() {
+        const size_t count = keys.size();
+        if (count < 2)
+            return;
+
+        std::vector<bool> removed;
+        auto merge_into = [&](size_t target, size_t duplicate) {
+            if (removed.empty())
+                removed.resize(count, false);
+
+            values[target].steal_value(values[duplicate]);
+            removed[duplicate] = true;
+        };
+
+        reset_key_index();
+
+        // Hashing only pays off once comparing every pair gets expensive
+        if (count <= 16) {
+            for (size_t i = 1; i < count; ++i) {
+                for (size_t j = 0; j < i; ++j) {
+                    if ((removed.empty() || !removed[j]) && keys[j].id() == keys[i].id()) {
+                        merge_into(j, i);
+                        break;
+                    }
+                }
+            }
         }
         else {
-            _children.push_back(value_copy);
-            _children_keys.push_back(key);
+            std::unique_ptr<KeyIndex> index = std::make_unique<KeyIndex>(count);
+
+            for (size_t i = 0; i < count; ++i) {
+                const int first_index = index->insert(keys, i);
+
+                if (first_index != -1)
+                    merge_into(first_index, i);
+            }
+
+            // Without duplicates the index is already complete, keep it for later lookups
+            if (removed.empty() && count >= object_key_index_threshold) {
+                key_index.store(index.release(), std::memory_order_release);
+                mark_external();
+            }
         }
+
+        if (removed.empty())
+            return;
+
+        reset_key_strings();
+
+        size_t write_index = 0;
+        for (size_t i = 0; i < count; ++i) {
+            if (removed[i])
+                continue;
+
+            if (write_index != i) {
+                keys[write_index] = std::move(keys[i]);
+                values[write_index].steal_value(values[i]);
+                values[write_index]._key = std::move(values[i]._key);
+            }
+            ++write_index;
+        }
+
+        keys.resize(write_index);
+        values.resize(write_index);
+    }
+
+
+    void Element::rename_key(int index, std::string_view new_key) {
+        if (_type != Type::Object)
+            throw MazeException("Cannot rename a key of non-object type.");
+
+        if (index < 0 || index >= get_storage().values.size())
+            throw MazeException("Object index out of range.");
+
+        Children& children = detach_children();
+        Key key = KeyTable::intern(new_key);
+
+        if (children.keys[index].id() == key.id())
+            return;
+
+        if (children.find_key(key.id()) != -1)
+            throw MazeException("Unable to rename key. Values map already contains an element with key " + std::string(new_key));
+
+        children.set_key(index, key);
+        children.values[index]._key = std::move(key);
+        children.reset_key_index();
+        children.reset_key_strings();
     }
 
+    void Element::rename_key(std::string_view key, std::string_view new_key) {
+        if (_type != Type::Object)
+            throw MazeException("Cannot rename a key of non-object type.");
 
-    void Element::remove(const std::string& key, bool update_string_indexes) {
+        const int value_index = index_of(key);
+        if (value_index != -1)
+            rename_key(value_index, new_key);
+    }
+
+    void Element::remove(std::string_view key, bool update_string_indexes) {
         if (_type != Type::Object)
             throw MazeException("Cannot remove an element from non-object type.");
 
         int value_index = index_of(key);
         if (value_index != -1) {
-            _children.erase(_children.begin() + value_index);
-            _children_keys.erase(_children_keys.begin() + value_index);
+            Children& children = detach_children();
+            children.erase(value_index);
+
+            if (update_string_indexes)
+                children.renumber_index_keys(value_index);
+        }
+    }
 
-            if (update_string_indexes) {
-                for (int i = (int)_children_keys.size() - 1; i > value_index; --i) {
-                    std::string key = _children_keys[i];
+    Element Element::take(std::string_view key) {
+        if (_type != Type::Object)
+            throw MazeException("Cannot take an element from non-object type.");
 
-                    if (key.length() > 0 && key[0] == array_index_prefix_char) {
-                        std::string new_key = array_index_prefix_char + std::to_string(i);
+        const int value_index = index_of(key);
+        if (value_index == -1)
+            return Element();
 
-                        if (key != new_key) {
-                            _children_keys[i] = new_key;
-                        }
-                    }
-                }
+        Children& children = detach_children();
+        Element taken(std::move(children.values[value_index]));
+        Key taken_key = std::move(children.values[value_index]._key);
+        children.erase(value_index);
+
+        return Element(std::move(taken), std::move(taken_key));
+    }
+
+    bool Element::exists(std::string_view key) const {
+        return index_of(key) != -1;
+    }
+
+    int Element::index_of(std::string_view key) const {
+        if (!is_container())
+            return -1;
+
+        const Children& children = get_storage();
+
+        if (_type == Type::Array) {
+            // Parse "~N" instead of generating keys to compare against
+            if (key.length() < 2 || key[0] != array_index_prefix_char || (key[1] == '0' && key.length() > 2))
+                return -1;
+
+            size_t index = 0;
+            for (size_t i = 1; i < key.length(); ++i) {
+                if (key[i] < '0' || key[i] > '9' || index > children.values.size())
+                    return -1;
+
+                index = index * 10 + (key[i] - '0');
             }
+
+            return index < children.values.size() ? (int)index : -1;
         }
-    }
 
-    bool Element::exists(const std::string& key) const {
-        if (_children_keys.size() != _children.size())
+        if (children.keys.size() != children.values.size())
             throw MazeException("Element corrupted, size of keys is different than size of element vector");
 
-        for (const auto& it : _children_keys) {
-            if (it == key)
-                return true;
-        }
+        // A key that was never interned cannot be in any object
+        const uint32_t key_id = KeyTable::find(key);
+        if (key_id == KeyTable::no_key)
+            return -1;
 
-        return false;
+        return children.find_key(key_id);
     }
 
-    int Element::index_of(const std::string& key) const {
-        if (_children_keys.size() != _children_keys.size())
-            throw MazeException("Element corrupted, size of keys is different than size of element vector");
+    const std::vector<std::string>& Element::get_keys() const {
+        static const std::vector<std::string> empty_keys_constant;
 
-        for (int i = (int)_children_keys.size() - 1; i >= 0; --i) {
-            if (_children_keys[i] == key)
-                return i;
-        }
+        if (is_container())
+            return get_storage().get_key_strings();
 
-        return -1;
+        return empty_keys_constant;
     }
 
 #pragma endregion
@@ -410,11 +1140,13 @@ namespace Maze {
             set_string(new_element.get_string());
             break;
         case Type::Array:
-            set_array(new_element.get_children());
+            copy_from_element(new_element);
             break;
         case Type::Object:
             if (_type == Type::Object) {
-                for (const std::string& key : new_element._children_keys) {
+                for (const Element& child : new_element.get_children()) {
+                    const std::string& key = child.get_key();
+
                     if (exists(key)) {
                         get_ref(key).apply(new_element.get(key));
                     }
@@ -424,7 +1156,7 @@ namespace Maze {
                 }
             }
             else {
-                set_object(new_element.get_keys(), new_element.get_children());
+                copy_from_element(new_element);
             }
             break;
         case Type::Function:
@@ -436,15 +1168,125 @@ namespace Maze {
     }
 
     std::string Element::to_json(int spacing) const {
-        return Helpers::Element::to_json_element(*this).dump(spacing);
+        std::string output;
+        if (is_container()) {
+            output.reserve(JsonWriter::cached_json_size(*this, spacing));
+        }
+
+        JsonWriter(output, spacing).write(*this);
+
+        return output;
     }
 
-    void Element::apply_json(const std::string& json_string) {
-        Helpers::Element::apply_json(*this, nlohmann::json::parse(json_string));
+    size_t Element::json_size(int spacing, bool use_cache) const {
+        return JsonWriter::json_size(*this, spacing, use_cache);
     }
 
-    Element Element::from_json(const std::string& json_string) {
-        return Helpers::Element::from_json(nlohmann::json::parse(json_string));
+    void Element::to_json(std::string& output, int spacing) const {
+        JsonWriter(output, spacing).write(*this);
+    }
+
+    void Element::to_json(std::ostream& stream, int spacing) const {
+        std::string buffer;
+        buffer.reserve(JsonWriter::chunk_size);
+
+        JsonWriter(buffer, spacing, [&stream](const char* data, size_t size) {
+            if (!stream.write(data, size))
+                throw MazeException("Unable to write JSON to stream");
+        }).write(*this);
+    }
+
+    void Element::to_json(std::FILE* file, int spacing) const {
+        std::string buffer;
+        buffer.reserve(JsonWriter::chunk_size);
+
+        JsonWriter(buffer, spacing, [file](const char* data, size_t size) {
+            if (std::fwrite(data, 1, size, file) != size)
+                throw MazeException("Unable to write JSON to file");
+        }).write(*this);
+    }
+
+    void Element::to_json_fd(int file_descriptor, int spacing) const {
+        std::string buffer;
+        buffer.reserve(JsonWriter::chunk_size);
+
+        JsonWriter(buffer, spacing, [file_descriptor](const char* data, size_t size) {
+            JsonWriter::write_fd(file_descriptor, data, size);
+        }).write(*this);
+    }
+
+    void Element::apply_json(std::string_view json_string) {
+        apply(from_json(json_string));
+    }
+
+    Element Element::from_json(std::string_view json_string) {
+        return from_json(json_string, std::pmr::get_default_resource());
+    }
+
+    Element Element::from_json(std::string_view json_string, std::pmr::memory_resource* resource) {
+        return JsonParser(json_string.data(), json_string.data() + json_string.size(), resource).parse();
+    }
+
+    Element Element::from_json(const char* data, size_t length) {
+        return from_json(std::string_view(data, length));
+    }
+
+    std::vector<uint8_t> Element::to_msgpack() const {
+        std::vector<uint8_t> output;
+        MsgPackWriter(output).write(*this);
+
+        return output;
+    }
+
+    Element Element::from_msgpack(const uint8_t* data, size_t size) {
+        return MsgPackReader(data, data + size).read();
+    }
+
+    Element Element::from_msgpack(const std::vector<uint8_t>& data) {
+        return from_msgpack(data.data(), data.size());
+    }
+
+    std::vector<uint8_t> Element::to_cbor() const {
+        std::vector<uint8_t> output;
+        CborWriter(output).write(*this);
+
+        return output;
+    }
+
+    Element Element::from_cbor(const uint8_t* data, size_t size) {
+        return CborReader(data, data + size).read();
+    }
+
+    Element Element::from_cbor(const std::vector<uint8_t>& data) {
+        return from_cbor(data.data(), data.size());
+    }
+
+    Element Element::from_json_lazy(std::string json_string) {
+        std::shared_ptr<LazyDocument> document = std::make_shared<LazyDocument>();
+        document->input = std::move(json_string);
+        document->begin = document->input.data();
+        document->end = document->begin + document->input.size();
+
+        return JsonParser::parse_lazy(std::move(document));
+    }
+
+    Element Element::from_json_file_lazy(const std::string& path) {
+        std::shared_ptr<LazyDocument> document = std::make_shared<LazyDocument>();
+        document->file = std::make_unique<MappedFile>(path);
+        document->begin = document->file->data();
+        document->end = document->begin + document->file->size();
+
+        return JsonParser::parse_lazy(std::move(document));
+    }
+
+    Element Element::from_json_file(const std::string& path) {
+        return from_json_file(path, std::pmr::get_default_resource());
+    }
+
+    Element Element::from_json_file(const std::string& path, std::pmr::memory_resource* resource) {
+        const MappedFile file(path);
+
+        return JsonParser(file.data(), file.data() + file.size(), resource).parse();
     }
 
     const Element& Element::get_null_element() {
@@ -453,4 +1295,8 @@ namespace Maze {
         return null_element;
     }
 
+    size_t Element::count_counted_keys() {
+        return KeyTable::count_counted();
+    }
+
 }  // namespace Maze
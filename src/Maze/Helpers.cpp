@@ -1,5 +1,33 @@
 #include <Maze/Helpers.hpp>
 #include <Maze/Maze.hpp>
+#include <climits>
+
+namespace Maze::Helpers {
+
+    namespace {
+
+        // nlohmann::json keeps 64 bit integers, the ones that do not fit an int become
+        // doubles the same way they do in Maze's own parser instead of being truncated
+        Maze::Element number_from_json(const Json& json) {
+            if (json.is_number_unsigned()) {
+                const Json::number_unsigned_t value = json.get_ref<const Json::number_unsigned_t&>();
+
+                return value <= INT_MAX ? Maze::Element((int)value) : Maze::Element((double)value);
+            }
+
+            if (json.is_number_integer()) {
+                const Json::number_integer_t value = json.get_ref<const Json::number_integer_t&>();
+
+                return value >= INT_MIN && value <= INT_MAX ? Maze::Element((int)value) : Maze::Element((double)value);
+            }
+
+            return Maze::Element(json.get_ref<const Json::number_float_t&>());
+        }
+
+    }  // namespace
+
+}  // namespace Maze::Helpers
+
 
 namespace Maze::Helpers::Element {
 
@@ -42,14 +70,11 @@ namespace Maze::Helpers::Element {
         if (json.is_boolean()) {
             el = json.get<bool>();
         }
-        else if (json.is_number_integer()) {
-            el = json.get<int>();
-        }
-        else if (json.is_number_float()) {
-            el = json.get<double>();
+        else if (json.is_number()) {
+            el = number_from_json(json);
         }
         else if (json.is_string()) {
-            el = json.get<std::string>();
+            el = json.get_ref<const std::string&>();
         }
         else if (json.is_array()) {
             el = Helpers::Array::from_json(json);
@@ -71,7 +96,7 @@ namespace Maze::Helpers::Array {
     Json to_json_array(const Maze::Element& array_el) {
         Json json_arr = Json::array();
 
-        auto children = array_el.get_children();
+        const auto& children = array_el.get_children();
         for (const auto& it : children) {
             json_arr.push_back(Element::to_json_element(it));
         }
@@ -81,16 +106,14 @@ namespace Maze::Helpers::Array {
 
     Maze::Element from_json(const Json& json_array) {
         Maze::Element array_el(Maze::Type::Array);
+        array_el.reserve(json_array.size());
 
         for (const auto& it : json_array) {
             if (it.is_string()) {
                 array_el.push_back(it.get<std::string>());
             }
-            else if (it.is_number_integer()) {
-                array_el.push_back(it.get<int>());
-            }
-            else if (it.is_number_float()) {
-                array_el.push_back(it.get<double>());
+            else if (it.is_number()) {
+                array_el.push_back(number_from_json(it));
             }
             else if (it.is_boolean()) {
                 array_el.push_back(it.get<bool>());
@@ -115,13 +138,10 @@ namespace Maze::Helpers::Array {
 namespace Maze::Helpers::Object {
 
     Json to_json_object(const Maze::Element& object_el) {
-        const auto& keys = object_el.get_keys();
-        const auto& val = object_el.get_children();
-
         Json json_obj = Json::object();
 
-        for (int i = 0; i < object_el.count_children(); ++i) {
-            json_obj[keys[i]] = Element::to_json_element(val[i]);
+        for (const Maze::Element& child : object_el.get_children()) {
+            json_obj[child.get_key()] = Element::to_json_element(child);
         }
 
         return json_obj;
@@ -129,29 +149,11 @@ namespace Maze::Helpers::Object {
 
     Maze::Element from_json(const Json& json_object) {
         Maze::Element object_el(Maze::Type::Object);
+        object_el.reserve(json_object.size());
 
+        // Keys are looked up straight from the json object, no copies are made
         for (auto it = json_object.begin(); it != json_object.end(); it++) {
-            if (it->is_string()) {
-                object_el.set(it.key(), it->get<std::string>());
-            }
-            else if (it->is_number_integer()) {
-                object_el.set(it.key(), it->get<int>());
-            }
-            else if (it->is_number_float()) {
-                object_el.set(it.key(), it->get<double>());
-            }
-            else if (it->is_boolean()) {
-                object_el.set(it.key(), it->get<bool>());
-            }
-            else if (it->is_array()) {
-                object_el.set(it.key(), Helpers::Array::from_json(*it));
-            }
-            else if (it->is_object()) {
-                object_el.set(it.key(), Helpers::Object::from_json(*it));
-            }
-            else if (it->is_null()) {
-                object_el.set(it.key(), Maze::Element(Type::Null));
-            }
+            object_el.set(std::string_view(it.key()), Helpers::Element::from_json(*it));
         }
 
         return object_el;
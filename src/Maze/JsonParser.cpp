@@ -0,0 +1,543 @@
+#include "JsonParser.hpp"
+#include "KeyTable.hpp"
+#include "StringScanner.hpp"
+#include <Maze/StructuralIndex.hpp>
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <cstdlib>
+#include <mutex>
+
+namespace Maze {
+
+    JsonParser::JsonParser(const char* begin, const char* end, std::pmr::memory_resource* resource)
+        : _begin(begin), _pos(begin), _end(end), _resource(resource) {}
+
+    Element JsonParser::parse() {
+        Element result;
+        parse(result);
+
+        return result;
+    }
+
+    void JsonParser::parse(Element& target) {
+        skip_whitespace();
+        parse_value(target, 0);
+        skip_whitespace();
+
+        if (_pos != _end)
+            fail("Unexpected trailing characters");
+    }
+
+    Element JsonParser::parse_lazy(std::shared_ptr<LazyDocument> document) {
+        JsonParser parser(document->begin, document->end);
+
+        // Scalars have nothing worth deferring
+        parser.skip_whitespace();
+        if (parser._pos == parser._end || (*parser._pos != '{' && *parser._pos != '['))
+            return parser.parse();
+
+        parser.index_containers(*document);
+
+        Element result;
+        parser.set_lazy(result, document, 0);
+
+        return result;
+    }
+
+    void JsonParser::parse_lazy_children(const Element::Children& children) {
+        // Containers are spread over a few locks so unrelated ones can be parsed in parallel.
+        // The low pointer bits are always zero for aligned blocks, so they are dropped first.
+        static std::mutex locks[64];
+        std::lock_guard<std::mutex> lock(locks[((uintptr_t)&children >> 4) % 64]);
+
+        Element::LazySource* source = children.lazy.load(std::memory_order_acquire);
+        if (source == nullptr)
+            return;
+
+        // Parsing children does not change the value of a container, only when it is done
+        Element::Children& target = const_cast<Element::Children&>(children);
+        const LazyDocument& document = *source->document;
+
+        try {
+            JsonParser(document.begin, document.end, target.get_resource())
+                .parse_container_children(target, source->document, source->container);
+        }
+        catch (...) {
+            target.values.clear();
+            target.keys.clear();
+            throw;
+        }
+
+        children.lazy.store(nullptr, std::memory_order_release);
+        delete source;
+    }
+
+    void JsonParser::decode_string(const char* begin, const char* end, std::pmr::string& target) {
+        JsonParser parser(begin, end);
+        parser.parse_string(target);
+
+        if (parser._pos != parser._end)
+            parser.fail("Unexpected trailing characters");
+    }
+
+    void JsonParser::index_containers(LazyDocument& document) {
+        std::vector<LazyDocument::Container>& containers = document.containers;
+        std::vector<size_t> open_containers;
+
+        // The input is indexed a window at a time to keep the positions in cache
+        const size_t window_size = 64 * 1024;
+        StructuralIndex index;
+        std::vector<uint32_t> positions;
+        positions.reserve(window_size / 4);
+
+        bool closed = false;
+        const char* window = _pos;
+        while (!closed && window != _end) {
+            const size_t size = std::min<size_t>(_end - window, window_size);
+
+            positions.clear();
+            index.scan(window, (uint32_t)size, positions);
+
+            for (uint32_t position : positions) {
+                const char c = window[position];
+
+                if (c == '{' || c == '[') {
+                    if (open_containers.size() >= max_depth) {
+                        _pos = window + position;
+                        fail("Maximum nesting depth exceeded");
+                    }
+
+                    open_containers.push_back(containers.size());
+                    containers.push_back(LazyDocument::Container{ (size_t)(window + position - _begin), 0, 0 });
+                }
+                else if (c == '}' || c == ']') {
+                    _pos = window + position;
+
+                    if (open_containers.empty())
+                        fail(std::string("Unexpected character '") + c + "'");
+
+                    LazyDocument::Container& container = containers[open_containers.back()];
+                    if (_begin[container.open] != (c == '}' ? '{' : '['))
+                        fail(c == '}' ? "Expected ',' or ']'" : "Expected ',' or '}'");
+
+                    container.close = _pos - _begin;
+                    container.next = containers.size();
+                    open_containers.pop_back();
+
+                    if (open_containers.empty()) {
+                        ++_pos;
+                        closed = true;
+                        break;
+                    }
+                }
+            }
+
+            window += size;
+        }
+
+        if (!closed) {
+            _pos = _end;
+            fail(index.in_string() ? "Unterminated string" : "Unexpected end of input");
+        }
+
+        skip_whitespace();
+        if (_pos != _end)
+            fail("Unexpected trailing characters");
+    }
+
+    void JsonParser::parse_container_children(Element::Children& target, const std::shared_ptr<LazyDocument>& document, size_t container) {
+        const LazyDocument::Container& current = document->containers[container];
+        const bool is_object = _begin[current.open] == '{';
+        const char close = is_object ? '}' : ']';
+        size_t next_container = container + 1;
+
+        _pos = _begin + current.open + 1;
+
+        skip_whitespace();
+        if (*_pos == close)
+            return;
+
+        std::pmr::string key;
+        while (true) {
+            skip_whitespace();
+
+            if (is_object) {
+                if (*_pos != '"')
+                    fail("Expected object key");
+
+                key.clear();
+                parse_string(key);
+
+                skip_whitespace();
+                expect(':');
+                skip_whitespace();
+            }
+
+            target.values.emplace_back();
+            Element& child = target.values.back();
+
+            if (is_object) {
+                child._key = KeyTable::intern(key);
+                target.add_key(child._key);
+            }
+
+            if (*_pos == '{' || *_pos == '[') {
+                // Nested containers stay unparsed, the index tells where they end
+                const LazyDocument::Container& nested = document->containers[next_container];
+
+                set_lazy(child, document, next_container);
+                _pos = _begin + nested.close + 1;
+                next_container = nested.next;
+            }
+            else {
+                parse_value(child, 0);
+            }
+
+            skip_whitespace();
+            if (*_pos == ',') {
+                ++_pos;
+            }
+            else if (*_pos == close) {
+                break;
+            }
+            else {
+                fail(is_object ? "Expected ',' or '}'" : "Expected ',' or ']'");
+            }
+        }
+
+        if (is_object)
+            target.remove_duplicate_keys();
+    }
+
+    void JsonParser::set_lazy(Element& target, const std::shared_ptr<LazyDocument>& document, size_t container) {
+        target.set_container(_begin[document->containers[container].open] == '{' ? Type::Object : Type::Array, _resource);
+        target._val_children->lazy.store(new Element::LazySource{ document, container }, std::memory_order_relaxed);
+        target._val_children->mark_external();
+    }
+
+    void JsonParser::parse_value(Element& target, int depth) {
+        if (_pos == _end)
+            fail("Unexpected end of input");
+
+        switch (*_pos) {
+        case '{':
+            parse_object(target, depth + 1);
+            break;
+        case '[':
+            parse_array(target, depth + 1);
+            break;
+        case '"':
+            parse_string(target.set_empty_string(_resource));
+            break;
+        case 't':
+            parse_literal("true", 4);
+            target.set_bool(true);
+            break;
+        case 'f':
+            parse_literal("false", 5);
+            target.set_bool(false);
+            break;
+        case 'n':
+            parse_literal("null", 4);
+            target.set_as_null();
+            break;
+        default:
+            if (*_pos == '-' || (*_pos >= '0' && *_pos <= '9'))
+                parse_number(target);
+            else
+                fail(std::string("Unexpected character '") + *_pos + "'");
+        }
+    }
+
+    void JsonParser::parse_array(Element& target, int depth) {
+        if (depth > max_depth)
+            fail("Maximum nesting depth exceeded");
+
+        ++_pos;
+        target.set_container(Type::Array, _resource);
+        Element::Children& children = *target._val_children;
+
+        skip_whitespace();
+        if (_pos != _end && *_pos == ']') {
+            ++_pos;
+            return;
+        }
+
+        while (true) {
+            children.values.emplace_back();
+            Element& child = children.values.back();
+
+            skip_whitespace();
+            parse_value(child, depth);
+            skip_whitespace();
+
+            if (_pos == _end)
+                fail("Unexpected end of input, expected ',' or ']'");
+
+            if (*_pos == ',') {
+                ++_pos;
+            }
+            else if (*_pos == ']') {
+                ++_pos;
+                return;
+            }
+            else {
+                fail("Expected ',' or ']'");
+            }
+        }
+    }
+
+    void JsonParser::parse_object(Element& target, int depth) {
+        if (depth > max_depth)
+            fail("Maximum nesting depth exceeded");
+
+        ++_pos;
+        target.set_container(Type::Object, _resource);
+        Element::Children& children = *target._val_children;
+
+        skip_whitespace();
+        if (_pos != _end && *_pos == '}') {
+            ++_pos;
+            return;
+        }
+
+        std::pmr::string key;
+        while (true) {
+            skip_whitespace();
+            if (_pos == _end || *_pos != '"')
+                fail("Expected object key");
+
+            key.clear();
+            parse_string(key);
+
+            skip_whitespace();
+            expect(':');
+            skip_whitespace();
+
+            children.values.emplace_back();
+            Element& child = children.values.back();
+            child._key = KeyTable::intern(key);
+            children.add_key(child._key);
+
+            parse_value(child, depth);
+
+            skip_whitespace();
+            if (_pos == _end)
+                fail("Unexpected end of input, expected ',' or '}'");
+
+            if (*_pos == ',') {
+                ++_pos;
+            }
+            else if (*_pos == '}') {
+                ++_pos;
+
+                // Duplicate keys keep the last value, same as set()
+                children.remove_duplicate_keys();
+                return;
+            }
+            else {
+                fail("Expected ',' or '}'");
+            }
+        }
+    }
+
+    void JsonParser::parse_string(std::pmr::string& target) {
+        ++_pos;
+
+        while (true) {
+            // Copy runs of characters that need no decoding in one go
+            const char* run_begin = _pos;
+            _pos = StringScanner::find_special(_pos, _end);
+            target.append(run_begin, _pos);
+
+            if (_pos == _end)
+                fail("Unterminated string");
+
+            const unsigned char c = (unsigned char)*_pos;
+
+            if (c == '"') {
+                ++_pos;
+                return;
+            }
+            else if (c == '\\') {
+                ++_pos;
+                if (_pos == _end)
+                    fail("Unterminated string");
+
+                switch (*_pos++) {
+                case '"': target.push_back('"'); break;
+                case '\\': target.push_back('\\'); break;
+                case '/': target.push_back('/'); break;
+                case 'b': target.push_back('\b'); break;
+                case 'f': target.push_back('\f'); break;
+                case 'n': target.push_back('\n'); break;
+                case 'r': target.push_back('\r'); break;
+                case 't': target.push_back('\t'); break;
+                case 'u': {
+                    unsigned int code_point = parse_hex4();
+
+                    if (code_point >= 0xD800 && code_point <= 0xDBFF) {
+                        if (_end - _pos < 6 || _pos[0] != '\\' || _pos[1] != 'u')
+                            fail("Missing low surrogate in \\u escape");
+
+                        _pos += 2;
+                        const unsigned int low_surrogate = parse_hex4();
+                        if (low_surrogate < 0xDC00 || low_surrogate > 0xDFFF)
+                            fail("Invalid low surrogate in \\u escape");
+
+                        code_point = 0x10000 + ((code_point - 0xD800) << 10) + (low_surrogate - 0xDC00);
+                    }
+                    else if (code_point >= 0xDC00 && code_point <= 0xDFFF) {
+                        fail("Unexpected low surrogate in \\u escape");
+                    }
+
+                    if (code_point < 0x80) {
+                        target.push_back((char)code_point);
+                    }
+                    else if (code_point < 0x800) {
+                        target.push_back((char)(0xC0 | (code_point >> 6)));
+                        target.push_back((char)(0x80 | (code_point & 0x3F)));
+                    }
+                    else if (code_point < 0x10000) {
+                        target.push_back((char)(0xE0 | (code_point >> 12)));
+                        target.push_back((char)(0x80 | ((code_point >> 6) & 0x3F)));
+                        target.push_back((char)(0x80 | (code_point & 0x3F)));
+                    }
+                    else {
+                        target.push_back((char)(0xF0 | (code_point >> 18)));
+                        target.push_back((char)(0x80 | ((code_point >> 12) & 0x3F)));
+                        target.push_back((char)(0x80 | ((code_point >> 6) & 0x3F)));
+                        target.push_back((char)(0x80 | (code_point & 0x3F)));
+                    }
+                    break;
+                }
+                default:
+                    --_pos;
+                    fail("Invalid escape sequence");
+                }
+            }
+            else if (c < 0x20) {
+                fail("Control characters must be escaped in strings");
+            }
+            else {
+                // Validate multi byte UTF-8 sequences and copy them as is
+                const char* sequences_begin = _pos;
+                _pos = StringScanner::skip_utf8(_pos, _end);
+
+                if (_pos == sequences_begin)
+                    fail("Invalid UTF-8 sequence in string");
+
+                target.append(sequences_begin, _pos);
+            }
+        }
+    }
+
+    void JsonParser::parse_number(Element& target) {
+        const char* number_begin = _pos;
+        bool is_integer = true;
+
+        if (*_pos == '-')
+            ++_pos;
+
+        if (_pos == _end || *_pos < '0' || *_pos > '9')
+            fail("Invalid number");
+
+        if (*_pos == '0') {
+            ++_pos;
+        }
+        else {
+            while (_pos != _end && *_pos >= '0' && *_pos <= '9')
+                ++_pos;
+        }
+
+        if (_pos != _end && *_pos == '.') {
+            is_integer = false;
+            ++_pos;
+
+            if (_pos == _end || *_pos < '0' || *_pos > '9')
+                fail("Invalid number, expected digit after decimal point");
+
+            while (_pos != _end && *_pos >= '0' && *_pos <= '9')
+                ++_pos;
+        }
+
+        if (_pos != _end && (*_pos == 'e' || *_pos == 'E')) {
+            is_integer = false;
+            ++_pos;
+
+            if (_pos != _end && (*_pos == '+' || *_pos == '-'))
+                ++_pos;
+
+            if (_pos == _end || *_pos < '0' || *_pos > '9')
+                fail("Invalid number, expected digit in exponent");
+
+            while (_pos != _end && *_pos >= '0' && *_pos <= '9')
+                ++_pos;
+        }
+
+        if (is_integer) {
+            int value;
+
+            if (std::from_chars(number_begin, _pos, value).ec == std::errc()) {
+                target.set_int(value);
+                return;
+            }
+        }
+
+        double value;
+        if (std::from_chars(number_begin, _pos, value).ec == std::errc::result_out_of_range) {
+            // from_chars leaves the value untouched on overflow and underflow, strtod
+            // rounds to infinity or zero instead. It needs a terminated copy.
+            value = std::strtod(std::string(number_begin, _pos).c_str(), nullptr);
+        }
+
+        target.set_double(value);
+    }
+
+    void JsonParser::parse_literal(const char* literal, size_t length) {
+        if ((size_t)(_end - _pos) < length || std::char_traits<char>::compare(_pos, literal, length) != 0)
+            fail(std::string("Invalid literal, expected '") + literal + "'");
+
+        _pos += length;
+    }
+
+    unsigned int JsonParser::parse_hex4() {
+        if (_end - _pos < 4)
+            fail("Truncated \\u escape");
+
+        unsigned int value = 0;
+        for (int i = 0; i < 4; ++i) {
+            const char c = *_pos++;
+            value <<= 4;
+
+            if (c >= '0' && c <= '9')
+                value |= c - '0';
+            else if (c >= 'a' && c <= 'f')
+                value |= c - 'a' + 10;
+            else if (c >= 'A' && c <= 'F')
+                value |= c - 'A' + 10;
+            else
+                fail("Invalid hex digit in \\u escape");
+        }
+
+        return value;
+    }
+
+    void JsonParser::skip_whitespace() {
+        while (_pos != _end && (*_pos == ' ' || *_pos == '\n' || *_pos == '\r' || *_pos == '\t'))
+            ++_pos;
+    }
+
+    void JsonParser::expect(char c) {
+        if (_pos == _end || *_pos != c)
+            fail(std::string("Expected '") + c + "'");
+
+        ++_pos;
+    }
+
+    void JsonParser::fail(const std::string& message) const {
+        throw MazeException("Unable to parse JSON: " + message + " at offset " + std::to_string(_pos - _begin));
+    }
+
+}  // namespace Maze
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <Maze/Maze.hpp>
+#include "MappedFile.hpp"
+
+namespace Maze {
+
+    // Input of a lazily parsed document together with the position of every
+    // array and object in it. Containers are stored in document order.
+    struct LazyDocument {
+        struct Container {
+            size_t open;
+            size_t close;
+            size_t next;  // First container that is not nested in this one
+        };
+
+        std::string input;
+        std::unique_ptr<MappedFile> file;
+        const char* begin = nullptr;
+        const char* end = nullptr;
+        std::vector<Container> containers;
+    };
+
+    struct Element::LazySource {
+        std::shared_ptr<LazyDocument> document;
+        size_t container;
+    };
+
+    // Single pass recursive descent JSON parser that builds Element trees
+    // directly from the input text without an intermediate DOM.
+    //
+    // Only the lazy parser walks a StructuralIndex, it has to find containers
+    // without building them. Eager parsing spends its time creating elements,
+    // skipping whitespace is a few percent of it even on indented input, so an
+    // index pass in front of it costs more than it saves.
+    class JsonParser {
+    public:
+        JsonParser(const char* begin, const char* end, std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+        Element parse();
+        void parse(Element& target);
+
+        static const int max_depth = 1024;
+
+        // Indexes the document and returns its root with unparsed children
+        static Element parse_lazy(std::shared_ptr<LazyDocument> document);
+        static void parse_lazy_children(const Element::Children& children);
+
+        // Decodes a complete quoted string, escapes included
+        static void decode_string(const char* begin, const char* end, std::pmr::string& target);
+
+    private:
+        void parse_value(Element& target, int depth);
+        void parse_array(Element& target, int depth);
+        void parse_object(Element& target, int depth);
+        void parse_string(std::pmr::string& target);
+        void parse_number(Element& target);
+        void parse_literal(const char* literal, size_t length);
+        unsigned int parse_hex4();
+
+        void index_containers(LazyDocument& document);
+        void parse_container_children(Element::Children& target, const std::shared_ptr<LazyDocument>& document, size_t container);
+        void set_lazy(Element& target, const std::shared_ptr<LazyDocument>& document, size_t container);
+
+        void skip_whitespace();
+        void expect(char c);
+
+        [[noreturn]] void fail(const std::string& message) const;
+
+        const char* _begin;
+        const char* _pos;
+        const char* _end;
+
+        // Containers of the parsed tree are allocated from here
+        std::pmr::memory_resource* _resource;
+    };
+
+}  // namespace Maze
@@ -0,0 +1,301 @@
+#include <Maze/JsonPushParser.hpp>
+#include <utility>
+#include "JsonParser.hpp"
+#include "KeyTable.hpp"
+#include "StringScanner.hpp"
+
+namespace Maze {
+
+    namespace {
+
+        inline bool is_whitespace(char c) {
+            return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+        }
+
+        // Numbers and literals run until the next delimiter and are parsed as a whole
+        inline bool is_scalar_char(char c) {
+            return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z')
+                || c == '-' || c == '+' || c == '.';
+        }
+
+    }  // namespace
+
+    JsonPushParser::JsonPushParser(std::pmr::memory_resource* resource)
+        : _resource(resource) {}
+
+    void JsonPushParser::feed(std::string_view chunk) {
+        const char* pos = chunk.data();
+        const char* end = pos + chunk.size();
+        _chunk = pos;
+
+        if (_state == State::Failed)
+            fail("Parser failed earlier, reset it first", pos);
+
+        while (pos != end) {
+            switch (_state) {
+            case State::String:
+            case State::KeyString:
+                pos = parse_string(pos, end);
+                break;
+            case State::Scalar:
+                pos = parse_scalar(pos, end);
+                break;
+            default:
+                while (pos != end && is_whitespace(*pos))
+                    ++pos;
+
+                if (pos != end)
+                    pos = parse_structure(pos);
+            }
+        }
+
+        _offset += chunk.size();
+    }
+
+    bool JsonPushParser::is_complete() const {
+        return _state == State::Done;
+    }
+
+    Element JsonPushParser::finish() {
+        _chunk = nullptr;
+
+        if (_state == State::Scalar && _stack.empty())
+            end_scalar(nullptr);
+
+        if (_state == State::Failed)
+            fail("Parser failed earlier, reset it first", nullptr);
+        if (_state != State::Done)
+            fail("Unexpected end of input", nullptr);
+
+        Element result = std::move(_root);
+        reset();
+
+        return result;
+    }
+
+    void JsonPushParser::reset() {
+        _state = State::Value;
+        _stack.clear();
+        _root.set_as_null();
+        _target = nullptr;
+        _token.clear();
+        _offset = 0;
+    }
+
+    const char* JsonPushParser::parse_structure(const char* pos) {
+        const char c = *pos;
+
+        switch (_state) {
+        case State::ArrayFirst:
+            if (c == ']') {
+                end_container();
+                return pos + 1;
+            }
+            [[fallthrough]];
+        case State::Value:
+            begin_value(pos);
+
+            // Scalars are read from their first character on
+            return _state == State::Scalar ? pos : pos + 1;
+        case State::ObjectFirst:
+            if (c == '}') {
+                end_container();
+                return pos + 1;
+            }
+            [[fallthrough]];
+        case State::Key:
+            if (c != '"')
+                fail("Expected object key", pos);
+
+            _token.clear();
+            _escaped = false;
+            _needs_decoding = false;
+            _state = State::KeyString;
+            return pos + 1;
+        case State::Colon:
+            if (c != ':')
+                fail("Expected ':'", pos);
+
+            _state = State::Value;
+            return pos + 1;
+        case State::AfterValue: {
+            const bool is_object = _stack.back().is_object;
+
+            if (c == ',') {
+                _state = is_object ? State::Key : State::Value;
+            }
+            else if (c == (is_object ? '}' : ']')) {
+                end_container();
+            }
+            else {
+                fail(is_object ? "Expected ',' or '}'" : "Expected ',' or ']'", pos);
+            }
+            return pos + 1;
+        }
+        case State::Done:
+            fail("Unexpected trailing characters", pos);
+        default:
+            fail(std::string("Unexpected character '") + c + "'", pos);
+        }
+    }
+
+    const char* JsonPushParser::parse_string(const char* pos, const char* end) {
+        while (pos != end) {
+            if (_escaped) {
+                _token.push_back(*pos++);
+                _escaped = false;
+                continue;
+            }
+
+            // Copy runs of characters that need no decoding in one go
+            const char* run_begin = pos;
+            pos = StringScanner::find_special(pos, end);
+            _token.append(run_begin, pos);
+
+            if (pos == end)
+                break;
+
+            const char c = *pos++;
+            if (c == '"') {
+                end_string(pos);
+                break;
+            }
+
+            // Escapes, control characters and UTF-8 are checked by the regular parser
+            _token.push_back(c);
+            _needs_decoding = true;
+            _escaped = c == '\\';
+        }
+
+        return pos;
+    }
+
+    const char* JsonPushParser::parse_scalar(const char* pos, const char* end) {
+        const char* run_begin = pos;
+        while (pos != end && is_scalar_char(*pos))
+            ++pos;
+
+        _token.append(run_begin, pos);
+
+        if (pos != end)
+            end_scalar(pos);
+
+        return pos;
+    }
+
+    void JsonPushParser::begin_value(const char* pos) {
+        const char c = *pos;
+
+        if (c == '{' || c == '[') {
+            if (_stack.size() >= (size_t)JsonParser::max_depth)
+                fail("Maximum nesting depth exceeded", pos);
+
+            Element& container = new_value();
+            container.set_container(c == '{' ? Type::Object : Type::Array, _resource);
+
+            _stack.push_back(Frame{ &container, c == '{' });
+            _state = c == '{' ? State::ObjectFirst : State::ArrayFirst;
+        }
+        else if (c == '"') {
+            _target = &new_value();
+            _token.clear();
+            _escaped = false;
+            _needs_decoding = false;
+            _state = State::String;
+        }
+        else if (is_scalar_char(c)) {
+            _target = &new_value();
+            _token.clear();
+            _state = State::Scalar;
+        }
+        else {
+            fail(std::string("Unexpected character '") + c + "'", pos);
+        }
+    }
+
+    // Element the next value is parsed into. Containers on the stack do not grow
+    // until their current child is finished, so pointers to it stay valid.
+    Element& JsonPushParser::new_value() {
+        if (_stack.empty())
+            return _root;
+
+        const Frame& frame = _stack.back();
+        Element::Children& children = *frame.container->_val_children;
+
+        children.values.emplace_back();
+        Element& child = children.values.back();
+
+        if (frame.is_object) {
+            children.add_key(_key);
+            child._key = std::move(_key);
+        }
+
+        return child;
+    }
+
+    void JsonPushParser::end_container() {
+        const Frame frame = _stack.back();
+        _stack.pop_back();
+
+        // Duplicate keys keep the last value, same as set()
+        if (frame.is_object)
+            frame.container->_val_children->remove_duplicate_keys();
+
+        end_value();
+    }
+
+    void JsonPushParser::end_string(const char* pos) {
+        // Values are decoded straight into the string of the element, on its container's resource
+        std::pmr::string key;
+        std::pmr::string& decoded = _state == State::KeyString ? key : _target->set_empty_string(_resource);
+
+        if (_needs_decoding) {
+            _token.insert(_token.begin(), '"');
+            _token.push_back('"');
+
+            try {
+                JsonParser::decode_string(_token.data(), _token.data() + _token.size(), decoded);
+            }
+            catch (const MazeException&) {
+                fail("Invalid string", pos);
+            }
+        }
+        else {
+            decoded.assign(_token);
+        }
+        _token.clear();
+
+        if (_state == State::KeyString) {
+            _key = KeyTable::intern(decoded);
+            _state = State::Colon;
+        }
+        else {
+            end_value();
+        }
+    }
+
+    void JsonPushParser::end_scalar(const char* pos) {
+        try {
+            JsonParser(_token.data(), _token.data() + _token.size(), _resource).parse(*_target);
+        }
+        catch (const MazeException&) {
+            fail("Invalid value '" + _token + "'", pos);
+        }
+        _token.clear();
+
+        end_value();
+    }
+
+    void JsonPushParser::end_value() {
+        _state = _stack.empty() ? State::Done : State::AfterValue;
+    }
+
+    // Offsets point at pos when it is known, at the end of the input fed so far otherwise
+    void JsonPushParser::fail(const std::string& message, const char* pos) {
+        const size_t offset = _offset + (pos != nullptr && _chunk != nullptr ? pos - _chunk : 0);
+        _state = State::Failed;
+
+        throw MazeException("Unable to parse JSON: " + message + " at offset " + std::to_string(offset));
+    }
+
+}  // namespace Maze
@@ -0,0 +1,84 @@
+#include <Maze/JsonSegments.hpp>
+#include <algorithm>
+#include "JsonWriter.hpp"
+
+#ifndef _WIN32
+#include <cerrno>
+#include <climits>
+#include <sys/uio.h>
+#endif
+
+namespace Maze {
+
+    JsonSegments::JsonSegments(const Element& el, int indentation_spacing, size_t min_reference_size)
+        : _scratch(new std::string()) {
+        JsonWriter(*_scratch, indentation_spacing, _segments, std::max<size_t>(min_reference_size, 1)).write(el);
+
+        // Scratch segments were recorded without data as the buffer could still move,
+        // they follow each other in the buffer in order
+        size_t scratch_offset = 0;
+        for (Segment& segment : _segments) {
+            if (segment.data == nullptr) {
+                segment.data = _scratch->data() + scratch_offset;
+                scratch_offset += segment.size;
+            }
+
+            _size += segment.size;
+        }
+    }
+
+    std::string JsonSegments::to_string() const {
+        std::string output;
+        output.reserve(_size);
+
+        for (const Segment& segment : _segments) {
+            output.append(segment.data, segment.size);
+        }
+
+        return output;
+    }
+
+    void JsonSegments::write_fd(int file_descriptor) const {
+#ifdef _WIN32
+        for (const Segment& segment : _segments) {
+            JsonWriter::write_fd(file_descriptor, segment.data, segment.size);
+        }
+#else
+#ifdef IOV_MAX
+        const size_t max_batch = IOV_MAX;
+#else
+        const size_t max_batch = 1024;
+#endif
+        std::vector<iovec> batch;
+        size_t index = 0;
+        size_t skip = 0;  // Bytes of the segment at index that were already written
+
+        while (index < _segments.size()) {
+            batch.clear();
+            for (size_t i = index; i < _segments.size() && batch.size() < max_batch; ++i) {
+                const size_t offset = i == index ? skip : 0;
+                batch.push_back(iovec{ (void*)(_segments[i].data + offset), _segments[i].size - offset });
+            }
+
+            ssize_t written = ::writev(file_descriptor, batch.data(), (int)batch.size());
+            if (written < 0 && errno == EINTR)
+                continue;
+            if (written <= 0)
+                throw MazeException("Unable to write JSON to file descriptor " + std::to_string(file_descriptor));
+
+            // Partial writes resume in the middle of a segment
+            for (const iovec& vector : batch) {
+                if ((size_t)written < vector.iov_len) {
+                    skip += written;
+                    break;
+                }
+
+                written -= vector.iov_len;
+                ++index;
+                skip = 0;
+            }
+        }
+#endif
+    }
+
+}  // namespace Maze
@@ -0,0 +1,385 @@
+#include <Maze/JsonStream.hpp>
+#include <fstream>
+#include <utility>
+
+namespace Maze {
+
+    JsonStream::JsonStream(Callback callback, std::vector<std::string> path)
+        : _callback(std::move(callback)), _path(std::move(path)) {}
+
+    void JsonStream::parse(std::istream& stream) {
+        _buffer.resize(buffer_size);
+        _stream = &stream;
+        _begin = _pos = _end = _buffer.data();
+
+        try {
+            parse_root();
+        }
+        catch (...) {
+            _stream = nullptr;
+            throw;
+        }
+
+        _stream = nullptr;
+    }
+
+    void JsonStream::parse(std::string_view json_string) {
+        _stream = nullptr;
+        _begin = _pos = json_string.data();
+        _end = _begin + json_string.size();
+
+        parse_root();
+    }
+
+    void JsonStream::parse_file(const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+            throw MazeException("Unable to open file " + path);
+
+        parse(file);
+    }
+
+    void JsonStream::parse_root() {
+        _offset = 0;
+        _count = 0;
+
+        skip_whitespace();
+        if (peek() < 0)
+            fail("Unexpected end of input");
+
+        parse_level(0);
+
+        skip_whitespace();
+        if (peek() >= 0)
+            fail("Unexpected trailing characters");
+    }
+
+    void JsonStream::parse_level(size_t level) {
+        skip_whitespace();
+
+        if (level == _path.size()) {
+            if (peek() == '[') {
+                parse_items();
+            }
+            else {
+                emit_value();
+            }
+            return;
+        }
+
+        // Nothing to stream if the path does not exist
+        if (peek() != '{') {
+            skip_value();
+            return;
+        }
+
+        next();
+        skip_whitespace();
+        if (peek() == '}') {
+            next();
+            return;
+        }
+
+        while (true) {
+            skip_whitespace();
+            if (peek() != '"')
+                fail("Expected object key");
+
+            _key.clear();
+            read_string(&_key);
+            decode_key();
+
+            skip_whitespace();
+            expect(':');
+
+            if (_key == _path[level]) {
+                parse_level(level + 1);
+            }
+            else {
+                skip_whitespace();
+                skip_value();
+            }
+
+            skip_whitespace();
+            const char c = next();
+            if (c == '}')
+                break;
+            if (c != ',')
+                fail("Expected ',' or '}'");
+        }
+    }
+
+    void JsonStream::parse_items() {
+        next();
+        skip_whitespace();
+        if (peek() == ']') {
+            next();
+            return;
+        }
+
+        while (true) {
+            skip_whitespace();
+            emit_value();
+
+            skip_whitespace();
+            const char c = next();
+            if (c == ']')
+                break;
+            if (c != ',')
+                fail("Expected ',' or ']'");
+        }
+    }
+
+    void JsonStream::emit_value() {
+        _value.clear();
+        read_value(&_value);
+
+        Element element;
+        try {
+            element = Element::from_json(_value);
+        }
+        catch (const MazeException& e) {
+            throw MazeException(std::string(e.what()) + " in streamed element " + std::to_string(_count));
+        }
+
+        ++_count;
+        _callback(std::move(element));
+    }
+
+    bool JsonStream::refill() {
+        if (_stream == nullptr)
+            return false;
+
+        _offset += _end - _begin;
+        _stream->read(_buffer.data(), _buffer.size());
+
+        _begin = _pos = _buffer.data();
+        _end = _begin + _stream->gcount();
+
+        return _pos != _end;
+    }
+
+    int JsonStream::peek() {
+        if (_pos == _end && !refill())
+            return -1;
+
+        return (unsigned char)*_pos;
+    }
+
+    char JsonStream::next() {
+        if (_pos == _end && !refill())
+            fail("Unexpected end of input");
+
+        return *_pos++;
+    }
+
+    void JsonStream::skip_whitespace() {
+        while (true) {
+            while (_pos != _end && (*_pos == ' ' || *_pos == '\t' || *_pos == '\n' || *_pos == '\r'))
+                ++_pos;
+
+            if (_pos != _end || !refill())
+                return;
+        }
+    }
+
+    void JsonStream::expect(char c) {
+        if (peek() != c)
+            fail(std::string("Expected '") + c + "'");
+
+        ++_pos;
+    }
+
+    // Copies the text of a single value to target, or skips it if target is null.
+    // Only strings and brackets are tracked, the value is validated when parsed.
+    void JsonStream::read_value(std::string* target) {
+        const int first = peek();
+
+        if (first == '"') {
+            read_string(target);
+        }
+        else if (first == '{' || first == '[') {
+            size_t depth = 0;
+
+            while (true) {
+                if (_pos == _end && !refill())
+                    fail("Unexpected end of input");
+
+                const char* start = _pos;
+                while (_pos != _end && *_pos != '"' && *_pos != '{' && *_pos != '[' && *_pos != '}' && *_pos != ']')
+                    ++_pos;
+
+                if (target)
+                    target->append(start, _pos);
+
+                if (_pos == _end)
+                    continue;
+
+                if (*_pos == '"') {
+                    read_string(target);
+                    continue;
+                }
+
+                const char c = *_pos++;
+                if (target)
+                    target->push_back(c);
+
+                if (c == '{' || c == '[') {
+                    ++depth;
+                }
+                else if (--depth == 0) {
+                    break;
+                }
+            }
+        }
+        else {
+            bool empty = true;
+
+            while (true) {
+                const char* start = _pos;
+                while (_pos != _end && *_pos != ',' && *_pos != ']' && *_pos != '}'
+                    && *_pos != ' ' && *_pos != '\t' && *_pos != '\n' && *_pos != '\r')
+                    ++_pos;
+
+                if (start != _pos) {
+                    empty = false;
+                    if (target)
+                        target->append(start, _pos);
+                }
+
+                if (_pos != _end || !refill())
+                    break;
+            }
+
+            if (empty)
+                fail(first < 0 ? "Unexpected end of input" : std::string("Unexpected character '") + (char)first + "'");
+        }
+    }
+
+    // Skips a single value without building it. Containers are tracked on a stack
+    // of open brackets instead of recursion and scalars are checked as a whole,
+    // so skipped values are held to the same grammar as parsed ones.
+    void JsonStream::skip_value() {
+        std::string open;
+
+        while (true) {
+            skip_whitespace();
+            const int c = peek();
+
+            if (c == '{' || c == '[') {
+                ++_pos;
+                skip_whitespace();
+
+                if (peek() != (c == '{' ? '}' : ']')) {
+                    open.push_back((char)c);
+                    if (c == '{')
+                        skip_key();
+                    continue;
+                }
+                ++_pos;
+            }
+            else if (c == '"') {
+                read_string(nullptr);
+            }
+            else {
+                skip_scalar();
+            }
+
+            // Close finished containers until one of them continues with another value
+            while (true) {
+                if (open.empty())
+                    return;
+
+                skip_whitespace();
+                const bool object = open.back() == '{';
+                const char d = next();
+
+                if (d == (object ? '}' : ']')) {
+                    open.pop_back();
+                    continue;
+                }
+                if (d != ',')
+                    fail(object ? "Expected ',' or '}'" : "Expected ',' or ']'");
+
+                if (object)
+                    skip_key();
+                break;
+            }
+        }
+    }
+
+    void JsonStream::skip_key() {
+        skip_whitespace();
+        if (peek() != '"')
+            fail("Expected object key");
+
+        read_string(nullptr);
+        skip_whitespace();
+        expect(':');
+    }
+
+    void JsonStream::skip_scalar() {
+        _token.clear();
+        read_value(&_token);
+
+        try {
+            Element::from_json(_token);
+        }
+        catch (const MazeException&) {
+            fail("Invalid value '" + _token + "'");
+        }
+    }
+
+    void JsonStream::read_string(std::string* target) {
+        if (target)
+            target->push_back('"');
+        ++_pos;
+
+        while (true) {
+            if (_pos == _end && !refill())
+                fail("Unterminated string");
+
+            const char* start = _pos;
+            while (_pos != _end && *_pos != '"' && *_pos != '\\')
+                ++_pos;
+
+            if (target)
+                target->append(start, _pos);
+
+            if (_pos == _end)
+                continue;
+
+            const char c = *_pos++;
+            if (target)
+                target->push_back(c);
+
+            if (c == '"')
+                return;
+
+            if (peek() < 0)
+                fail("Unterminated string");
+            if (std::string_view("\"\\/bfnrtu").find(*_pos) == std::string_view::npos)
+                fail("Invalid escape sequence");
+
+            if (target)
+                target->push_back(*_pos);
+            ++_pos;
+        }
+    }
+
+    // Replaces the quoted key text in _key with its value
+    void JsonStream::decode_key() {
+        if (_key.find('\\') == std::string::npos) {
+            _key.erase(_key.size() - 1, 1);
+            _key.erase(0, 1);
+        }
+        else {
+            _key = Element::from_json(_key).get_string();
+        }
+    }
+
+    void JsonStream::fail(const std::string& message) const {
+        throw MazeException("Unable to parse JSON stream: " + message + " at offset " + std::to_string(_offset + (_pos - _begin)));
+    }
+
+}  // namespace Maze
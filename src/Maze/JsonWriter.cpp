@@ -0,0 +1,440 @@
+#include "JsonWriter.hpp"
+#include "KeyTable.hpp"
+#include "StringScanner.hpp"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <utility>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <cerrno>
+#include <unistd.h>
+#endif
+
+namespace Maze {
+
+    JsonWriter::JsonWriter(std::string& output, int indentation_spacing)
+        : _out(output), _indentation_spacing(indentation_spacing) {}
+
+    JsonWriter::JsonWriter(std::string& buffer, int indentation_spacing, Sink sink)
+        : _out(buffer), _indentation_spacing(indentation_spacing), _sink(std::move(sink)), _flush_size(chunk_size) {}
+
+    JsonWriter::JsonWriter(std::string& scratch, int indentation_spacing, std::vector<JsonSegments::Segment>& segments, size_t min_reference_size)
+        : _out(scratch), _indentation_spacing(indentation_spacing), _segments(&segments), _min_reference_size(min_reference_size) {}
+
+    void JsonWriter::write(const Element& el) {
+        write_value(el, 0);
+
+        if (_segments)
+            end_scratch_segment();
+
+        if (_sink) {
+            flush();
+
+            if (!_out.empty())
+                _sink(_out.data(), _out.size());
+            _out.clear();
+        }
+    }
+
+    void JsonWriter::write_fd(int file_descriptor, const char* data, size_t size) {
+        while (size > 0) {
+#ifdef _WIN32
+            const int written = _write(file_descriptor, data, (unsigned int)size);
+#else
+            const ssize_t written = ::write(file_descriptor, data, size);
+            if (written < 0 && errno == EINTR)
+                continue;
+#endif
+            if (written <= 0)
+                throw MazeException("Unable to write JSON to file descriptor " + std::to_string(file_descriptor));
+
+            data += written;
+            size -= written;
+        }
+    }
+
+    size_t JsonWriter::json_size(const Element& el, int indentation_spacing, bool use_cache) {
+        return measure(el, use_cache).get(indentation_spacing, 0);
+    }
+
+    size_t JsonWriter::cached_json_size(const Element& el, int indentation_spacing) {
+        if (!el.is_container())
+            return 0;
+
+        const Element::JsonSize* cached = el._val_children->json_size.load(std::memory_order_acquire);
+        if (cached == nullptr)
+            return 0;
+
+        return cached->get(indentation_spacing, 0);
+    }
+
+    Element::JsonSize JsonWriter::measure(const Element& el, bool use_cache) {
+        Element::JsonSize size;
+
+        switch (el.get_type()) {
+        case Type::Bool:
+            size.compact = el._val_bool ? 4 : 5;
+            return size;
+        case Type::Int: {
+            char buffer[16];
+            size.compact = std::to_chars(buffer, buffer + sizeof(buffer), el._val_int).ptr - buffer;
+            return size;
+        }
+        case Type::Double: {
+            char buffer[32];
+            size.compact = format_double(el._val_double, buffer);
+            return size;
+        }
+        case Type::String:
+            size.compact = measure_string(el._val_string);
+            return size;
+        case Type::Array:
+        case Type::Object:
+            break;
+        default:
+            size.compact = 4;
+            return size;
+        }
+
+        const Element::Children& children = el.get_storage();
+
+        // Writes through references into borrowed children could change them unnoticed
+        use_cache = use_cache && !children.borrowed;
+
+        if (use_cache) {
+            const Element::JsonSize* cached = children.json_size.load(std::memory_order_acquire);
+            if (cached != nullptr)
+                return *cached;
+        }
+
+        const size_t count = children.values.size();
+        size.compact = count == 0 ? 2 : count + 1;
+
+        if (count > 0) {
+            // Every child starts on a new line one level deeper, the closing bracket on one at this level
+            size.newlines = count + 1;
+            size.indentation = count;
+        }
+
+        for (size_t i = 0; i < count; ++i) {
+            const Element::JsonSize child = measure(children.values[i], use_cache);
+
+            size.compact += child.compact;
+            size.newlines += child.newlines;
+            size.indentation += child.indentation + child.newlines;
+            size.keys += child.keys;
+        }
+
+        if (el.is_object()) {
+            for (const Element::Key& key : children.keys) {
+                size.compact += measure_string(KeyTable::get(key.id())) + 1;
+            }
+            size.keys += count;
+        }
+
+        if (use_cache) {
+            // Another reader may have published the same size in the meantime, keep the first one
+            std::unique_ptr<Element::JsonSize> created = std::make_unique<Element::JsonSize>(size);
+            Element::JsonSize* expected = nullptr;
+            if (children.json_size.compare_exchange_strong(expected, created.get(), std::memory_order_acq_rel)) {
+                created.release();
+                children.mark_external();
+            }
+        }
+
+        return size;
+    }
+
+    size_t JsonWriter::measure_string(std::string_view value) {
+        const char* pos = value.data();
+        const char* end = pos + value.size();
+        size_t size = value.size() + 2;
+
+        while (pos != end) {
+            pos = StringScanner::find_special(pos, end);
+            if (pos == end)
+                break;
+
+            const unsigned char c = (unsigned char)*pos;
+
+            if (c >= 0x80) {
+                const char* sequences_begin = pos;
+                pos = StringScanner::skip_utf8(pos, end);
+
+                if (pos == sequences_begin)
+                    throw MazeException("Unable to serialize JSON: invalid UTF-8 byte at index " + std::to_string(pos - value.data()));
+
+                continue;
+            }
+
+            // Short escapes add a backslash, other control characters become \u00XX
+            const bool short_escape = c == '"' || c == '\\' || c == '\b' || c == '\f' || c == '\n' || c == '\r' || c == '\t';
+            size += short_escape ? 1 : 5;
+            ++pos;
+        }
+
+        return size;
+    }
+
+    void JsonWriter::write_value(const Element& el, int level) {
+        switch (el.get_type()) {
+        case Type::Bool:
+            _out += el._val_bool ? "true" : "false";
+            break;
+        case Type::Int: {
+            char buffer[16];
+            _out.append(buffer, std::to_chars(buffer, buffer + sizeof(buffer), el._val_int).ptr);
+            break;
+        }
+        case Type::Double:
+            write_double(el._val_double);
+            break;
+        case Type::String:
+            write_string(el._val_string);
+            break;
+        case Type::Array:
+            write_array(el, level);
+            break;
+        case Type::Object:
+            write_object(el, level);
+            break;
+        default:
+            _out += "null";
+            break;
+        }
+    }
+
+    void JsonWriter::write_array(const Element& el, int level) {
+        const Element::ChildVector& values = el.get_storage().values;
+
+        if (values.empty()) {
+            _out += "[]";
+            return;
+        }
+
+        _out.push_back('[');
+        for (size_t i = 0; i < values.size(); ++i) {
+            if (i > 0)
+                _out.push_back(',');
+
+            write_newline(level + 1);
+            write_value(values[i], level + 1);
+            flush_if_full();
+        }
+        write_newline(level);
+        _out.push_back(']');
+    }
+
+    void JsonWriter::write_object(const Element& el, int level) {
+        const std::pmr::vector<Element::Key>& keys = el.get_storage().keys;
+        const Element::ChildVector& values = el.get_storage().values;
+
+        if (values.empty()) {
+            _out += "{}";
+            return;
+        }
+
+        _out.push_back('{');
+        for (size_t i = 0; i < values.size(); ++i) {
+            if (i > 0)
+                _out.push_back(',');
+
+            write_newline(level + 1);
+            write_string(KeyTable::get(keys[i].id()));
+            _out += _indentation_spacing >= 0 ? ": " : ":";
+            write_value(values[i], level + 1);
+            flush_if_full();
+        }
+        write_newline(level);
+        _out.push_back('}');
+    }
+
+    void JsonWriter::write_string(std::string_view value) {
+        static const char hex_digits[] = "0123456789abcdef";
+
+        _out.push_back('"');
+
+        const char* pos = value.data();
+        const char* end = pos + value.size();
+
+        while (pos != end) {
+            // Append runs of characters that need no escaping in one go
+            const char* run_begin = pos;
+            pos = StringScanner::find_special(pos, end);
+            append(run_begin, pos - run_begin);
+
+            if (pos == end)
+                break;
+
+            const unsigned char c = (unsigned char)*pos;
+
+            if (c >= 0x80) {
+                // Multi byte UTF-8 sequences are copied as is once they are validated
+                const char* sequences_begin = pos;
+                pos = StringScanner::skip_utf8(pos, end);
+
+                if (pos == sequences_begin)
+                    throw MazeException("Unable to serialize JSON: invalid UTF-8 byte at index " + std::to_string(pos - value.data()));
+
+                _out.append(sequences_begin, pos);
+                continue;
+            }
+
+            switch (c) {
+            case '"': _out += "\\\""; break;
+            case '\\': _out += "\\\\"; break;
+            case '\b': _out += "\\b"; break;
+            case '\f': _out += "\\f"; break;
+            case '\n': _out += "\\n"; break;
+            case '\r': _out += "\\r"; break;
+            case '\t': _out += "\\t"; break;
+            default:
+                _out += "\\u00";
+                _out.push_back(hex_digits[c >> 4]);
+                _out.push_back(hex_digits[c & 0x0F]);
+                break;
+            }
+            ++pos;
+        }
+
+        _out.push_back('"');
+    }
+
+    void JsonWriter::write_double(double value) {
+        char buffer[32];
+        _out.append(buffer, format_double(value, buffer));
+    }
+
+    size_t JsonWriter::format_double(double value, char* output) {
+        char* out = output;
+
+        if (!std::isfinite(value)) {
+            std::memcpy(out, "null", 4);
+            return 4;
+        }
+
+        if (value == 0) {
+            if (std::signbit(value))
+                *out++ = '-';
+
+            std::memcpy(out, "0.0", 3);
+            return out + 3 - output;
+        }
+
+        // Shortest digits that read back as the same value, as "[-]d.ddde[+-]xx"
+        char buffer[32];
+        const char* end = std::to_chars(buffer, buffer + sizeof(buffer), value, std::chars_format::scientific).ptr;
+        const char* pos = buffer;
+
+        if (*pos == '-') {
+            *out++ = '-';
+            ++pos;
+        }
+
+        char digits[17];
+        int k = 0;
+        for (; *pos != 'e'; ++pos) {
+            if (*pos != '.')
+                digits[k++] = *pos;
+        }
+
+        int exponent = 0;
+        for (const char* exponent_digit = pos + 2; exponent_digit != end; ++exponent_digit) {
+            exponent = exponent * 10 + (*exponent_digit - '0');
+        }
+        if (pos[1] == '-')
+            exponent = -exponent;
+
+        // Same layout as nlohmann::json: plain notation for decimal exponents in
+        // (-4, 15], scientific notation with at least two exponent digits otherwise
+        const int n = exponent + 1;
+
+        if (k <= n && n <= 15) {
+            out = std::copy(digits, digits + k, out);
+            out = std::fill_n(out, n - k, '0');
+            *out++ = '.';
+            *out++ = '0';
+        }
+        else if (0 < n && n <= 15) {
+            out = std::copy(digits, digits + n, out);
+            *out++ = '.';
+            out = std::copy(digits + n, digits + k, out);
+        }
+        else if (-4 < n && n <= 0) {
+            *out++ = '0';
+            *out++ = '.';
+            out = std::fill_n(out, -n, '0');
+            out = std::copy(digits, digits + k, out);
+        }
+        else {
+            *out++ = digits[0];
+            if (k > 1) {
+                *out++ = '.';
+                out = std::copy(digits + 1, digits + k, out);
+            }
+
+            *out++ = 'e';
+            *out++ = exponent < 0 ? '-' : '+';
+            if (std::abs(exponent) < 10)
+                *out++ = '0';
+
+            out = std::to_chars(out, out + 8, std::abs(exponent)).ptr;
+        }
+
+        return out - output;
+    }
+
+    // Long strings are split over several chunks when writing to a sink
+    void JsonWriter::append(const char* data, size_t size) {
+        if (size >= _min_reference_size) {
+            end_scratch_segment();
+            _segments->push_back(JsonSegments::Segment{ data, size });
+            return;
+        }
+
+        while (_out.size() + size > _flush_size) {
+            const size_t part = _flush_size - std::min(_out.size(), _flush_size);
+            _out.append(data, part);
+            flush();
+
+            data += part;
+            size -= part;
+        }
+
+        _out.append(data, size);
+    }
+
+    void JsonWriter::end_scratch_segment() {
+        if (_out.size() == _scratch_segment_begin)
+            return;
+
+        _segments->push_back(JsonSegments::Segment{ nullptr, _out.size() - _scratch_segment_begin });
+        _scratch_segment_begin = _out.size();
+    }
+
+    // Punctuation, escapes and indentation are appended past the limit, the sink
+    // only gets whole chunks and the rest waits for the next flush
+    void JsonWriter::flush() {
+        size_t offset = 0;
+        while (_out.size() - offset >= chunk_size) {
+            _sink(_out.data() + offset, chunk_size);
+            offset += chunk_size;
+        }
+
+        _out.erase(0, offset);
+    }
+
+    void JsonWriter::write_newline(int level) {
+        if (_indentation_spacing < 0)
+            return;
+
+        _out.push_back('\n');
+        _out.append((size_t)level * _indentation_spacing, ' ');
+    }
+
+}  // namespace Maze
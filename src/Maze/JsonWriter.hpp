@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <Maze/Maze.hpp>
+#include <Maze/JsonSegments.hpp>
+
+namespace Maze {
+
+    // Length of the JSON of an element split by what it depends on, so one
+    // measurement serves every indentation and nesting level
+    struct Element::JsonSize {
+        size_t compact = 0;      // Length without any whitespace
+        size_t newlines = 0;     // Line breaks added when indenting
+        size_t indentation = 0;  // Sum of the levels of those lines, relative to the element
+        size_t keys = 0;         // Object keys followed by a space when indenting
+
+        inline size_t get(int indentation_spacing, int level) const {
+            if (indentation_spacing < 0)
+                return compact;
+
+            return compact + keys + newlines + (indentation + (size_t)level * newlines) * indentation_spacing;
+        }
+    };
+
+    // Serializes Element trees straight into a single output buffer. A negative
+    // indentation produces compact output, otherwise every value is placed on
+    // its own line indented by the given number of spaces per level.
+    //
+    // With a sink the output buffer is handed to it in chunks of chunk_size
+    // bytes whenever it fills up, only the last chunk is shorter.
+    //
+    // With segments, string runs of at least min_reference_size bytes are not
+    // copied but recorded as segments pointing into the element. The output
+    // buffer holds everything else and is recorded as segments without data,
+    // in order, for the caller to point into once writing is done.
+    class JsonWriter {
+    public:
+        using Sink = std::function<void(const char* data, size_t size)>;
+
+        JsonWriter(std::string& output, int indentation_spacing);
+        JsonWriter(std::string& buffer, int indentation_spacing, Sink sink);
+        JsonWriter(std::string& scratch, int indentation_spacing, std::vector<JsonSegments::Segment>& segments, size_t min_reference_size);
+
+        void write(const Element& el);
+
+        // Exact length of the output of write, without generating it. Cached sizes
+        // are stored in containers and reused until they are modified or borrowed.
+        static size_t json_size(const Element& el, int indentation_spacing, bool use_cache);
+        // Cached size of a container that was not modified since, 0 if there is none
+        static size_t cached_json_size(const Element& el, int indentation_spacing);
+
+        // Shortest text that reads back as value, output needs room for 32 characters
+        static size_t format_double(double value, char* output);
+
+        // Writes all of data to a file descriptor, retrying partial writes
+        static void write_fd(int file_descriptor, const char* data, size_t size);
+
+        static const size_t chunk_size = 64 * 1024;
+
+    private:
+        static Element::JsonSize measure(const Element& el, bool use_cache);
+        static size_t measure_string(std::string_view value);
+
+        void write_value(const Element& el, int level);
+        void write_array(const Element& el, int level);
+        void write_object(const Element& el, int level);
+        void write_string(std::string_view value);
+        void write_double(double value);
+        void write_newline(int level);
+        void append(const char* data, size_t size);
+
+        inline void flush_if_full() {
+            if (_out.size() >= _flush_size)
+                flush();
+        }
+        void flush();
+        void end_scratch_segment();
+
+        std::string& _out;
+        int _indentation_spacing;
+
+        Sink _sink;
+        size_t _flush_size = SIZE_MAX;
+
+        std::vector<JsonSegments::Segment>* _segments = nullptr;
+        size_t _min_reference_size = SIZE_MAX;
+        size_t _scratch_segment_begin = 0;
+    };
+
+}  // namespace Maze
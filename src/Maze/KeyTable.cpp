@@ -0,0 +1,281 @@
+#include "KeyTable.hpp"
+#include <algorithm>
+#include <functional>
+
+namespace Maze {
+
+    KeyTable::Table::Table(size_t size)
+        : mask(size - 1), slots(new std::atomic<uint64_t>[size]) {
+        for (size_t i = 0; i < size; ++i)
+            slots[i].store(0, std::memory_order_relaxed);
+    }
+
+    template <typename T>
+    KeyTable::Chunks<T>::Directory::Directory(size_t capacity)
+        : capacity(capacity), chunks(new T*[capacity]()) {}
+
+    template <typename T>
+    KeyTable::Chunks<T>::Chunks() {
+        _directories.push_back(std::make_unique<Directory>(64));
+        _directory.store(_directories.back().get(), std::memory_order_relaxed);
+    }
+
+    template <typename T>
+    T& KeyTable::Chunks<T>::operator[](uint32_t index) const {
+        const Directory* directory = _directory.load(std::memory_order_acquire);
+
+        return directory->chunks[index >> chunk_bits][index & (chunk_size - 1)];
+    }
+
+    template <typename T>
+    T& KeyTable::Chunks<T>::allocate(uint32_t index) {
+        const size_t chunk_index = index >> chunk_bits;
+
+        Directory* directory = _directory.load(std::memory_order_relaxed);
+        if (chunk_index >= directory->capacity) {
+            std::unique_ptr<Directory> grown = std::make_unique<Directory>(std::max(directory->capacity * 2, chunk_index + 1));
+            std::copy(directory->chunks.get(), directory->chunks.get() + directory->capacity, grown->chunks.get());
+
+            directory = grown.get();
+            _directories.push_back(std::move(grown));
+            _directory.store(directory, std::memory_order_release);
+        }
+        if (directory->chunks[chunk_index] == nullptr) {
+            _chunks.push_back(std::make_unique<T[]>(chunk_size));
+            directory->chunks[chunk_index] = _chunks.back().get();
+        }
+
+        return directory->chunks[chunk_index][index & (chunk_size - 1)];
+    }
+
+    KeyTable::KeyTable()
+        : _shards(new Shard[shard_count]) {
+        _tables.push_back(std::make_unique<Table>(1024));
+        _table.store(_tables.back().get(), std::memory_order_relaxed);
+
+        // Id 0 is the empty key, it is never added to the hash table
+        _keys.allocate(0);
+    }
+
+    KeyTable& KeyTable::instance() {
+        // Never destroyed, static elements may still refer to keys during shutdown
+        static KeyTable* table = new KeyTable();
+
+        return *table;
+    }
+
+    uint32_t KeyTable::hash(std::string_view key) {
+        return (uint32_t)std::hash<std::string_view>()(key);
+    }
+
+    Element::Key KeyTable::intern(std::string_view key) {
+        if (key.empty())
+            return Element::Key();
+
+        KeyTable& table = instance();
+        const uint32_t key_hash = hash(key);
+        uint32_t id = table.find(key, key_hash);
+
+        if (id != no_key)
+            return Element::Key(id);
+
+        if (key.size() <= max_permanent_key_length && !table._permanent_full.load(std::memory_order_acquire)) {
+            id = table.add(key, key_hash);
+
+            if (id != no_key)
+                return Element::Key(id);
+        }
+
+        return Element::Key(table.add_counted(key, key_hash));
+    }
+
+    uint32_t KeyTable::find(std::string_view key) {
+        if (key.empty())
+            return 0;
+
+        KeyTable& table = instance();
+        const uint32_t key_hash = hash(key);
+        const uint32_t id = table.find(key, key_hash);
+
+        if (id != no_key || !table._has_counted.load(std::memory_order_acquire))
+            return id;
+
+        return table.find_counted(key, key_hash);
+    }
+
+    const std::string& KeyTable::get(uint32_t id) {
+        if (id & Element::Key::counted_bit)
+            return instance().get_counted(id).key;
+
+        return instance()._keys[id];
+    }
+
+    void KeyTable::acquire(uint32_t id) noexcept {
+        instance().get_counted(id).references.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void KeyTable::release(uint32_t id) noexcept {
+        KeyTable& table = instance();
+        CountedKey& entry = table.get_counted(id);
+
+        // The caller still holds a reference, so the key cannot be released in between
+        const uint32_t generation = entry.generation.load(std::memory_order_relaxed);
+        if (entry.references.fetch_sub(1, std::memory_order_acq_rel) != 1)
+            return;
+
+        Shard& shard = table._shards[(id >> shard_shift) & (shard_count - 1)];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        // Interned again while waiting for the lock, or already released by that user
+        if (entry.references.load(std::memory_order_relaxed) != 0 || entry.generation.load(std::memory_order_relaxed) != generation)
+            return;
+
+        shard.indices.erase(entry.key);
+        std::string().swap(entry.key);
+        entry.generation.store(generation + 1, std::memory_order_relaxed);
+        shard.free_indices.push_back(id & shard_index_mask);
+    }
+
+    size_t KeyTable::count_counted() {
+        KeyTable& table = instance();
+        size_t count = 0;
+
+        for (uint32_t i = 0; i < shard_count; ++i) {
+            Shard& shard = table._shards[i];
+            std::lock_guard<std::mutex> lock(shard.mutex);
+
+            count += shard.count - shard.free_indices.size();
+        }
+
+        return count;
+    }
+
+    uint32_t KeyTable::find(std::string_view key, uint32_t key_hash) const {
+        const Table* table = _table.load(std::memory_order_acquire);
+
+        for (size_t i = key_hash & table->mask;; i = (i + 1) & table->mask) {
+            const uint64_t entry = table->slots[i].load(std::memory_order_acquire);
+
+            if (entry == 0)
+                return no_key;
+
+            if ((uint32_t)(entry >> 32) == key_hash && _keys[(uint32_t)entry] == key)
+                return (uint32_t)entry;
+        }
+    }
+
+    uint32_t KeyTable::add(std::string_view key, uint32_t key_hash) {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        // Another thread may have added the key while we were waiting
+        uint32_t id = find(key, key_hash);
+        if (id != no_key)
+            return id;
+
+        if (_count == max_permanent_keys || _bytes + key.size() > max_permanent_bytes) {
+            _permanent_full.store(true, std::memory_order_release);
+            return no_key;
+        }
+
+        id = _count;
+        _keys.allocate(id) = std::string(key);
+        _bytes += key.size();
+
+        Table* table = _table.load(std::memory_order_relaxed);
+        if ((size_t)_count * 2 > table->mask) {
+            std::unique_ptr<Table> grown = std::make_unique<Table>((table->mask + 1) * 2);
+
+            for (size_t i = 0; i <= table->mask; ++i) {
+                const uint64_t entry = table->slots[i].load(std::memory_order_relaxed);
+                if (entry == 0)
+                    continue;
+
+                size_t slot = (entry >> 32) & grown->mask;
+                while (grown->slots[slot].load(std::memory_order_relaxed) != 0)
+                    slot = (slot + 1) & grown->mask;
+
+                grown->slots[slot].store(entry, std::memory_order_relaxed);
+            }
+
+            table = grown.get();
+            _tables.push_back(std::move(grown));
+            _table.store(table, std::memory_order_release);
+        }
+
+        size_t slot = key_hash & table->mask;
+        while (table->slots[slot].load(std::memory_order_relaxed) != 0)
+            slot = (slot + 1) & table->mask;
+
+        // Publishing the entry makes the stored key visible to readers that find it
+        table->slots[slot].store(((uint64_t)key_hash << 32) | id, std::memory_order_release);
+        ++_count;
+
+        return id;
+    }
+
+    uint32_t KeyTable::add_counted(std::string_view key, uint32_t key_hash) {
+        const uint32_t shard_index = key_hash >> (32 - shard_bits);
+        Shard& shard = _shards[shard_index];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        // A key added to the permanent part before it filled up stays there
+        const uint32_t permanent_id = find(key, key_hash);
+        if (permanent_id != no_key)
+            return permanent_id;
+
+        auto it = shard.indices.find(key);
+        if (it != shard.indices.end()) {
+            shard.keys[it->second].references.fetch_add(1, std::memory_order_relaxed);
+
+            return Element::Key::counted_bit | (shard_index << shard_shift) | it->second;
+        }
+
+        uint32_t index;
+        if (!shard.free_indices.empty()) {
+            index = shard.free_indices.back();
+            shard.free_indices.pop_back();
+        }
+        else {
+            // The last index of the last shard would be no_key
+            if (shard.count == shard_index_mask)
+                throw MazeException("Unable to intern key, the key table is full");
+
+            index = shard.count++;
+            shard.keys.allocate(index);
+        }
+
+        CountedKey& entry = shard.keys[index];
+        entry.key = std::string(key);
+        entry.references.store(1, std::memory_order_relaxed);
+        shard.indices.emplace(entry.key, index);
+
+        _has_counted.store(true, std::memory_order_release);
+
+        return Element::Key::counted_bit | (shard_index << shard_shift) | index;
+    }
+
+    uint32_t KeyTable::find_counted(std::string_view key, uint32_t key_hash) {
+        const uint32_t shard_index = key_hash >> (32 - shard_bits);
+        Shard& shard = _shards[shard_index];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        auto it = shard.indices.find(key);
+        if (it == shard.indices.end())
+            return no_key;
+
+        return Element::Key::counted_bit | (shard_index << shard_shift) | it->second;
+    }
+
+    KeyTable::CountedKey& KeyTable::get_counted(uint32_t id) const {
+        return _shards[(id >> shard_shift) & (shard_count - 1)].keys[id & shard_index_mask];
+    }
+
+    void Element::Key::acquire(uint32_t id) noexcept {
+        KeyTable::acquire(id);
+    }
+
+    void Element::Key::release(uint32_t id) noexcept {
+        KeyTable::release(id);
+    }
+
+}  // namespace Maze
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <Maze/Maze.hpp>
+
+namespace Maze {
+
+    // Process wide table of object keys. Every distinct key is stored once and
+    // elements refer to it by a 32 bit id, id 0 is the empty key.
+    //
+    // The first keys, up to max_permanent_keys or max_permanent_bytes and no
+    // longer than max_permanent_key_length, are permanent. Their ids and strings
+    // stay valid forever and looking them up does not lock. Keys past those
+    // limits are counted: elements own a reference through Element::Key and the
+    // key is released with the last one, so documents with ever changing keys
+    // do not grow the table. Counted keys are spread over shards that each have
+    // their own mutex, taken when such a key is interned, looked up or released.
+    class KeyTable {
+    public:
+        static const uint32_t no_key = UINT32_MAX;
+
+        static const uint32_t max_permanent_keys = 65536;
+        static const size_t max_permanent_bytes = 4 * 1024 * 1024;
+        static const size_t max_permanent_key_length = 256;
+
+        static Element::Key intern(std::string_view key);
+        // Returns no_key for keys that are not in the table. Counted ids are only
+        // meaningful to compare against ids owned by the caller.
+        static uint32_t find(std::string_view key);
+        static const std::string& get(uint32_t id);
+
+        static void acquire(uint32_t id) noexcept;
+        static void release(uint32_t id) noexcept;
+
+        static size_t count_counted();
+
+    private:
+        static const size_t chunk_bits = 10;
+        static const size_t chunk_size = (size_t)1 << chunk_bits;
+
+        // Counted ids have Element::Key::counted_bit set, followed by the shard
+        // and the index of the key within the shard
+        static const uint32_t shard_bits = 4;
+        static const uint32_t shard_count = 1u << shard_bits;
+        static const uint32_t shard_shift = 31 - shard_bits;
+        static const uint32_t shard_index_mask = (1u << shard_shift) - 1;
+
+        // Open addressing table of (hash << 32 | id) entries, 0 marks an empty slot.
+        // Tables are replaced when full and kept around for readers still probing them.
+        struct Table {
+            size_t mask;
+            std::unique_ptr<std::atomic<uint64_t>[]> slots;
+
+            explicit Table(size_t size);
+        };
+
+        // Values stored in fixed size chunks so they never move. The directory of
+        // chunks is replaced when it grows, old directories are kept like tables.
+        template <typename T>
+        class Chunks {
+        public:
+            Chunks();
+
+            T& operator[](uint32_t index) const;
+            // Makes room for index, called with the lock of the owner held
+            T& allocate(uint32_t index);
+
+        private:
+            struct Directory {
+                size_t capacity;
+                std::unique_ptr<T*[]> chunks;
+
+                explicit Directory(size_t capacity);
+            };
+
+            std::atomic<Directory*> _directory;
+            std::vector<std::unique_ptr<Directory>> _directories;
+            std::vector<std::unique_ptr<T[]>> _chunks;
+        };
+
+        struct CountedKey {
+            std::string key;
+            std::atomic<uint32_t> references = 0;
+            // Bumped when the key is released, so a late release of an earlier use is ignored
+            std::atomic<uint32_t> generation = 0;
+        };
+
+        struct Shard {
+            std::mutex mutex;
+            std::unordered_map<std::string_view, uint32_t> indices;
+            std::vector<uint32_t> free_indices;
+            uint32_t count = 0;
+            Chunks<CountedKey> keys;
+        };
+
+        KeyTable();
+
+        static KeyTable& instance();
+        static uint32_t hash(std::string_view key);
+
+        uint32_t find(std::string_view key, uint32_t key_hash) const;
+        // Returns no_key once the permanent part is full
+        uint32_t add(std::string_view key, uint32_t key_hash);
+        uint32_t add_counted(std::string_view key, uint32_t key_hash);
+        uint32_t find_counted(std::string_view key, uint32_t key_hash);
+        CountedKey& get_counted(uint32_t id) const;
+
+        std::atomic<Table*> _table;
+        Chunks<std::string> _keys;
+        uint32_t _count = 1;
+        size_t _bytes = 0;
+
+        std::atomic<bool> _permanent_full = false;
+        std::atomic<bool> _has_counted = false;
+
+        std::mutex _mutex;
+        std::vector<std::unique_ptr<Table>> _tables;
+
+        std::unique_ptr<Shard[]> _shards;
+    };
+
+}  // namespace Maze
@@ -0,0 +1,103 @@
+#include "MappedFile.hpp"
+#include <Maze/Maze.hpp>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Maze {
+
+#ifdef _WIN32
+
+    MappedFile::MappedFile(const std::string& path) {
+        _file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (_file == INVALID_HANDLE_VALUE) {
+            _file = nullptr;
+            throw MazeException("Unable to open file " + path);
+        }
+
+        LARGE_INTEGER file_size;
+        if (!GetFileSizeEx(_file, &file_size)) {
+            CloseHandle(_file);
+            throw MazeException("Unable to read size of file " + path);
+        }
+
+        _size = (size_t)file_size.QuadPart;
+        if (_size == 0)
+            return;
+
+        _mapping = CreateFileMappingA(_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (_mapping == nullptr) {
+            CloseHandle(_file);
+            throw MazeException("Unable to map file " + path);
+        }
+
+        _data = (const char*)MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0);
+        if (_data == nullptr) {
+            CloseHandle(_mapping);
+            CloseHandle(_file);
+            throw MazeException("Unable to map file " + path);
+        }
+    }
+
+    MappedFile::~MappedFile() {
+        if (_data != nullptr)
+            UnmapViewOfFile(_data);
+        if (_mapping != nullptr)
+            CloseHandle(_mapping);
+        if (_file != nullptr)
+            CloseHandle(_file);
+    }
+
+#else
+
+    MappedFile::MappedFile(const std::string& path) {
+        const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd == -1)
+            throw MazeException("Unable to open file " + path + ": " + std::strerror(errno));
+
+        struct stat file_stat;
+        if (fstat(fd, &file_stat) == -1) {
+            const int error = errno;
+            close(fd);
+            throw MazeException("Unable to read size of file " + path + ": " + std::strerror(error));
+        }
+
+        _size = (size_t)file_stat.st_size;
+        if (_size == 0) {
+            close(fd);
+            return;
+        }
+
+        void* mapping = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+        const int error = errno;
+
+        // The mapping keeps its own reference to the file
+        close(fd);
+
+        if (mapping == MAP_FAILED)
+            throw MazeException("Unable to map file " + path + ": " + std::strerror(error));
+
+#ifdef MADV_SEQUENTIAL
+        madvise(mapping, _size, MADV_SEQUENTIAL);
+#endif
+
+        _data = (const char*)mapping;
+    }
+
+    MappedFile::~MappedFile() {
+        if (_data != nullptr)
+            munmap((void*)_data, _size);
+    }
+
+#endif
+
+}  // namespace Maze
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace Maze {
+
+    // Read only view of a whole file mapped into memory, so it can be parsed in
+    // place without reading it into a buffer first. The view is unmapped when
+    // the object is destroyed.
+    class MappedFile {
+    public:
+        explicit MappedFile(const std::string& path);
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        inline const char* data() const { return _data; }
+        inline size_t size() const { return _size; }
+
+    private:
+        const char* _data = nullptr;
+        size_t _size = 0;
+
+#ifdef _WIN32
+        void* _file = nullptr;
+        void* _mapping = nullptr;
+#endif
+    };
+
+}  // namespace Maze
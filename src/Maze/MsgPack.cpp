@@ -0,0 +1,337 @@
+#include "MsgPack.hpp"
+#include "KeyTable.hpp"
+#include <cfloat>
+#include <climits>
+#include <cmath>
+#include <cstring>
+
+namespace Maze {
+
+    MsgPackWriter::MsgPackWriter(std::vector<uint8_t>& output)
+        : _out(output) {}
+
+    void MsgPackWriter::write(const Element& el) {
+        write_value(el);
+    }
+
+    void MsgPackWriter::write_value(const Element& el) {
+        switch (el.get_type()) {
+        case Type::Bool:
+            _out.push_back(el._val_bool ? 0xc3 : 0xc2);
+            break;
+        case Type::Int:
+            write_int(el._val_int);
+            break;
+        case Type::Double:
+            write_double(el._val_double);
+            break;
+        case Type::String:
+            write_string(el._val_string);
+            break;
+        case Type::Array: {
+            const Element::Children& children = el.get_storage();
+
+            write_header(0x90, 16, 0xdc, children.values.size());
+            for (const Element& child : children.values) {
+                write_value(child);
+            }
+            break;
+        }
+        case Type::Object: {
+            const Element::Children& children = el.get_storage();
+
+            write_header(0x80, 16, 0xde, children.values.size());
+            for (size_t i = 0; i < children.values.size(); ++i) {
+                write_string(KeyTable::get(children.keys[i].id()));
+                write_value(children.values[i]);
+            }
+            break;
+        }
+        default:
+            _out.push_back(0xc0);
+            break;
+        }
+    }
+
+    void MsgPackWriter::write_int(int value) {
+        if (value >= -32 && value <= 127) {
+            _out.push_back((uint8_t)value);
+        }
+        else if (value > 0) {
+            if (value <= UINT8_MAX) {
+                _out.push_back(0xcc);
+                write_big_endian(value, 1);
+            }
+            else if (value <= UINT16_MAX) {
+                _out.push_back(0xcd);
+                write_big_endian(value, 2);
+            }
+            else {
+                _out.push_back(0xce);
+                write_big_endian(value, 4);
+            }
+        }
+        else {
+            if (value >= INT8_MIN) {
+                _out.push_back(0xd0);
+                write_big_endian((uint8_t)value, 1);
+            }
+            else if (value >= INT16_MIN) {
+                _out.push_back(0xd1);
+                write_big_endian((uint16_t)value, 2);
+            }
+            else {
+                _out.push_back(0xd2);
+                write_big_endian((uint32_t)value, 4);
+            }
+        }
+    }
+
+    void MsgPackWriter::write_double(double value) {
+        // Converting a finite double outside the float range is undefined behaviour
+        if (!std::isfinite(value) || std::fabs(value) <= FLT_MAX) {
+            const float narrow = (float)value;
+
+            if ((double)narrow == value) {
+                uint32_t bits;
+                std::memcpy(&bits, &narrow, sizeof(bits));
+
+                _out.push_back(0xca);
+                write_big_endian(bits, 4);
+                return;
+            }
+        }
+
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+
+        _out.push_back(0xcb);
+        write_big_endian(bits, 8);
+    }
+
+    void MsgPackWriter::write_string(std::string_view value) {
+        if (value.size() < 32) {
+            _out.push_back(0xa0 | (uint8_t)value.size());
+        }
+        else if (value.size() <= UINT8_MAX) {
+            _out.push_back(0xd9);
+            write_big_endian(value.size(), 1);
+        }
+        else {
+            write_header(0, 0, 0xda, value.size());
+        }
+
+        _out.insert(_out.end(), value.begin(), value.end());
+    }
+
+    // Arrays, maps and long strings share the layout of fix, 16 and 32 bit size headers
+    void MsgPackWriter::write_header(uint8_t fix_type, size_t fix_limit, uint8_t type_16, size_t size) {
+        if (size < fix_limit) {
+            _out.push_back(fix_type | (uint8_t)size);
+        }
+        else if (size <= UINT16_MAX) {
+            _out.push_back(type_16);
+            write_big_endian(size, 2);
+        }
+        else if (size <= UINT32_MAX) {
+            _out.push_back(type_16 + 1);
+            write_big_endian(size, 4);
+        }
+        else {
+            throw MazeException("Unable to write MessagePack: size " + std::to_string(size) + " is too large");
+        }
+    }
+
+    void MsgPackWriter::write_big_endian(uint64_t value, int bytes) {
+        for (int shift = (bytes - 1) * 8; shift >= 0; shift -= 8) {
+            _out.push_back((uint8_t)(value >> shift));
+        }
+    }
+
+
+    MsgPackReader::MsgPackReader(const uint8_t* begin, const uint8_t* end)
+        : _begin(begin), _pos(begin), _end(end) {}
+
+    Element MsgPackReader::read() {
+        Element result;
+        read_value(result, 0);
+
+        if (_pos != _end)
+            fail("Unexpected trailing bytes");
+
+        return result;
+    }
+
+    void MsgPackReader::read_value(Element& target, int depth) {
+        if (_pos == _end)
+            fail("Unexpected end of input");
+
+        const uint8_t type = *_pos++;
+
+        if (type <= 0x7f || type >= 0xe0) {
+            target.set_int((int8_t)type);
+        }
+        else if (type <= 0x8f) {
+            read_object(target, type & 0x0f, depth + 1);
+        }
+        else if (type <= 0x9f) {
+            read_array(target, type & 0x0f, depth + 1);
+        }
+        else if (type <= 0xbf) {
+            read_string(target.set_empty_string(std::pmr::get_default_resource()), type & 0x1f);
+        }
+        else {
+            switch (type) {
+            case 0xc0:
+                target.set_as_null();
+                break;
+            case 0xc2:
+                target.set_bool(false);
+                break;
+            case 0xc3:
+                target.set_bool(true);
+                break;
+            case 0xc4: case 0xc5: case 0xc6:
+            case 0xd9: case 0xda: case 0xdb: {
+                const int size_bytes = 1 << (type >= 0xd9 ? type - 0xd9 : type - 0xc4);
+
+                read_string(target.set_empty_string(std::pmr::get_default_resource()), read_big_endian(size_bytes));
+                break;
+            }
+            case 0xca: {
+                const uint32_t bits = (uint32_t)read_big_endian(4);
+                float value;
+                std::memcpy(&value, &bits, sizeof(value));
+
+                target.set_double(value);
+                break;
+            }
+            case 0xcb: {
+                const uint64_t bits = read_big_endian(8);
+                double value;
+                std::memcpy(&value, &bits, sizeof(value));
+
+                target.set_double(value);
+                break;
+            }
+            case 0xcc: case 0xcd: case 0xce: case 0xcf: {
+                const uint64_t value = read_big_endian(1 << (type - 0xcc));
+
+                if (value <= INT_MAX)
+                    target.set_int((int)value);
+                else
+                    target.set_double((double)value);
+                break;
+            }
+            case 0xd0: case 0xd1: case 0xd2: case 0xd3: {
+                const int bytes = 1 << (type - 0xd0);
+                const int unused_bits = 64 - bytes * 8;
+
+                // Sign extend from the encoded width
+                const int64_t value = (int64_t)(read_big_endian(bytes) << unused_bits) >> unused_bits;
+
+                if (value >= INT_MIN && value <= INT_MAX)
+                    target.set_int((int)value);
+                else
+                    target.set_double((double)value);
+                break;
+            }
+            case 0xdc: case 0xdd:
+                read_array(target, read_big_endian(type == 0xdc ? 2 : 4), depth + 1);
+                break;
+            case 0xde: case 0xdf:
+                read_object(target, read_big_endian(type == 0xde ? 2 : 4), depth + 1);
+                break;
+            default:
+                --_pos;
+                fail("Unsupported type " + std::to_string(type));
+            }
+        }
+    }
+
+    void MsgPackReader::read_array(Element& target, size_t size, int depth) {
+        if (depth > max_depth)
+            fail("Maximum nesting depth exceeded");
+
+        target.set_container(Type::Array, std::pmr::get_default_resource());
+        Element::Children& children = *target._val_children;
+
+        // Every value takes at least a byte, do not trust larger sizes
+        children.values.reserve(std::min<size_t>(size, _end - _pos));
+
+        for (size_t i = 0; i < size; ++i) {
+            children.values.emplace_back();
+            read_value(children.values.back(), depth);
+        }
+    }
+
+    void MsgPackReader::read_object(Element& target, size_t size, int depth) {
+        if (depth > max_depth)
+            fail("Maximum nesting depth exceeded");
+
+        target.set_container(Type::Object, std::pmr::get_default_resource());
+        Element::Children& children = *target._val_children;
+
+        children.values.reserve(std::min<size_t>(size, (_end - _pos) / 2));
+        children.keys.reserve(children.values.capacity());
+
+        std::pmr::string key;
+        for (size_t i = 0; i < size; ++i) {
+            key.clear();
+            read_key(key);
+
+            children.values.emplace_back();
+            Element& child = children.values.back();
+            child._key = KeyTable::intern(key);
+            children.add_key(child._key);
+
+            read_value(child, depth);
+        }
+
+        // Duplicate keys keep the last value, same as set()
+        children.remove_duplicate_keys();
+    }
+
+    void MsgPackReader::read_key(std::pmr::string& target) {
+        if (_pos == _end)
+            fail("Unexpected end of input");
+
+        const uint8_t type = *_pos++;
+
+        if (type >= 0xa0 && type <= 0xbf) {
+            read_string(target, type & 0x1f);
+        }
+        else if (type >= 0xd9 && type <= 0xdb) {
+            read_string(target, read_big_endian(1 << (type - 0xd9)));
+        }
+        else {
+            --_pos;
+            fail("Map keys must be strings");
+        }
+    }
+
+    void MsgPackReader::read_string(std::pmr::string& target, size_t size) {
+        if ((size_t)(_end - _pos) < size)
+            fail("Unexpected end of input");
+
+        target.assign((const char*)_pos, size);
+        _pos += size;
+    }
+
+    uint64_t MsgPackReader::read_big_endian(int bytes) {
+        if (_end - _pos < bytes)
+            fail("Unexpected end of input");
+
+        uint64_t value = 0;
+        for (int i = 0; i < bytes; ++i) {
+            value = (value << 8) | *_pos++;
+        }
+
+        return value;
+    }
+
+    void MsgPackReader::fail(const std::string& message) const {
+        throw MazeException("Unable to read MessagePack: " + message + " at offset " + std::to_string(_pos - _begin));
+    }
+
+}  // namespace Maze
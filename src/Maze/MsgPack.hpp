@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <Maze/Maze.hpp>
+
+namespace Maze {
+
+    // Encodes Element trees as MessagePack. Integers and strings use the
+    // smallest fitting format, doubles are stored as float 32 when that is
+    // lossless. Functions are written as nil, same as in JSON.
+    class MsgPackWriter {
+    public:
+        explicit MsgPackWriter(std::vector<uint8_t>& output);
+
+        void write(const Element& el);
+
+    private:
+        void write_value(const Element& el);
+        void write_int(int value);
+        void write_double(double value);
+        void write_string(std::string_view value);
+        void write_header(uint8_t fix_type, size_t fix_limit, uint8_t type_16, size_t size);
+        void write_big_endian(uint64_t value, int bytes);
+
+        std::vector<uint8_t>& _out;
+    };
+
+    // Decodes MessagePack into Element trees. Integers outside the int range
+    // become doubles, binary values become strings and map keys have to be
+    // strings. Extension types are rejected.
+    class MsgPackReader {
+    public:
+        MsgPackReader(const uint8_t* begin, const uint8_t* end);
+
+        Element read();
+
+        static const int max_depth = 1024;
+
+    private:
+        void read_value(Element& target, int depth);
+        void read_array(Element& target, size_t size, int depth);
+        void read_object(Element& target, size_t size, int depth);
+        void read_key(std::pmr::string& target);
+        void read_string(std::pmr::string& target, size_t size);
+        uint64_t read_big_endian(int bytes);
+
+        [[noreturn]] void fail(const std::string& message) const;
+
+        const uint8_t* _begin;
+        const uint8_t* _pos;
+        const uint8_t* _end;
+    };
+
+}  // namespace Maze
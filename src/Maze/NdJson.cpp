@@ -0,0 +1,159 @@
+#include <Maze/NdJson.hpp>
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <thread>
+#include "JsonWriter.hpp"
+#include "MappedFile.hpp"
+
+namespace Maze {
+
+    namespace {
+
+        unsigned int resolve_thread_count(unsigned int thread_count) {
+            if (thread_count == 0)
+                thread_count = std::thread::hardware_concurrency();
+
+            return std::max(thread_count, 1u);
+        }
+
+        // Runs task for every index in [0, task_count) on up to thread_count threads,
+        // the calling thread included. The first failed task in index order is rethrown.
+        void run_parallel(size_t task_count, unsigned int thread_count, const std::function<void(size_t)>& task) {
+            std::vector<std::exception_ptr> errors(task_count);
+            std::atomic<size_t> next_task = 0;
+
+            auto worker = [&]() {
+                for (size_t i = next_task++; i < task_count; i = next_task++) {
+                    try {
+                        task(i);
+                    }
+                    catch (...) {
+                        errors[i] = std::current_exception();
+                    }
+                }
+            };
+
+            std::vector<std::thread> threads;
+            const size_t extra_threads = std::min<size_t>(thread_count, task_count) - 1;
+            for (size_t i = 0; i < extra_threads; ++i) {
+                threads.emplace_back(worker);
+            }
+
+            worker();
+
+            for (auto& thread : threads) {
+                thread.join();
+            }
+
+            for (const auto& error : errors) {
+                if (error)
+                    std::rethrow_exception(error);
+            }
+        }
+
+        void parse_lines(std::string_view input, size_t begin, size_t end, std::vector<Element>& output) {
+            while (begin < end) {
+                size_t line_end = input.find('\n', begin);
+                if (line_end == std::string_view::npos || line_end > end)
+                    line_end = end;
+
+                const std::string_view line = input.substr(begin, line_end - begin);
+
+                if (line.find_first_not_of(" \t\r") != std::string_view::npos) {
+                    try {
+                        output.push_back(Element::from_json(line));
+                    }
+                    catch (const MazeException& e) {
+                        const size_t line_number = 1 + std::count(input.begin(), input.begin() + begin, '\n');
+                        throw MazeException(std::string(e.what()) + " on line " + std::to_string(line_number));
+                    }
+                }
+
+                begin = line_end + 1;
+            }
+        }
+
+    }  // namespace
+
+    std::vector<Element> NdJson::parse(std::string_view input, unsigned int thread_count) {
+        thread_count = resolve_thread_count(thread_count);
+
+        // A few blocks per thread even out lines of uneven cost. Block bounds are
+        // moved forward to the start of the next line.
+        const size_t block_count = std::min<size_t>(thread_count * 4, std::max<size_t>(input.size() / min_block_size, 1));
+
+        std::vector<size_t> bounds = { 0 };
+        for (size_t i = 1; i < block_count; ++i) {
+            const size_t line_end = input.find('\n', std::max(input.size() / block_count * i, bounds.back()));
+            if (line_end == std::string_view::npos)
+                break;
+
+            bounds.push_back(line_end + 1);
+        }
+        bounds.push_back(input.size());
+
+        std::vector<std::vector<Element>> blocks(bounds.size() - 1);
+        run_parallel(blocks.size(), thread_count, [&](size_t i) {
+            parse_lines(input, bounds[i], bounds[i + 1], blocks[i]);
+        });
+
+        if (blocks.size() == 1)
+            return std::move(blocks[0]);
+
+        size_t total = 0;
+        for (const auto& block : blocks) {
+            total += block.size();
+        }
+
+        std::vector<Element> result;
+        result.reserve(total);
+        for (auto& block : blocks) {
+            std::move(block.begin(), block.end(), std::back_inserter(result));
+        }
+
+        return result;
+    }
+
+    std::vector<Element> NdJson::parse_file(const std::string& path, unsigned int thread_count) {
+        MappedFile file(path);
+
+        return parse(std::string_view(file.data(), file.size()), thread_count);
+    }
+
+    std::string NdJson::write(const std::vector<Element>& elements, unsigned int thread_count) {
+        thread_count = resolve_thread_count(thread_count);
+
+        const size_t block_count = std::min<size_t>(thread_count * 4, std::max<size_t>(elements.size() / min_block_elements, 1));
+        const size_t block_elements = (elements.size() + block_count - 1) / block_count;
+
+        std::vector<std::string> blocks(block_count);
+        run_parallel(block_count, thread_count, [&](size_t i) {
+            const size_t end = std::min(elements.size(), (i + 1) * block_elements);
+
+            JsonWriter writer(blocks[i], -1);
+            for (size_t j = i * block_elements; j < end; ++j) {
+                writer.write(elements[j]);
+                blocks[i].push_back('\n');
+            }
+        });
+
+        if (block_count == 1)
+            return std::move(blocks[0]);
+
+        size_t total = 0;
+        for (const auto& block : blocks) {
+            total += block.size();
+        }
+
+        std::string result;
+        result.reserve(total);
+        for (const auto& block : blocks) {
+            result += block;
+        }
+
+        return result;
+    }
+
+}  // namespace Maze
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+
+// Vector instruction sets available to the scanners. SSE2 is part of every
+// x86-64 target and used directly, AVX2 functions are compiled with
+// MAZE_SIMD_TARGET_AVX2 and only called when Simd::has_avx2() is true.
+#if defined(__SSE2__) || defined(_M_X64)
+#define MAZE_SIMD_SSE2
+#include <emmintrin.h>
+#endif
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define MAZE_SIMD_AVX2
+#define MAZE_SIMD_TARGET_AVX2 __attribute__((target("avx2")))
+#include <immintrin.h>
+#endif
+
+namespace Maze {
+
+    namespace Simd {
+
+        inline unsigned int count_trailing_zeros(uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+            return __builtin_ctzll(value);
+#else
+            unsigned int count = 0;
+            while ((value & 1) == 0) {
+                value >>= 1;
+                ++count;
+            }
+            return count;
+#endif
+        }
+
+        // Checked once, the answer does not change while the process runs
+        inline bool has_avx2() {
+#ifdef MAZE_SIMD_AVX2
+            static const bool supported = __builtin_cpu_supports("avx2");
+
+            return supported;
+#else
+            return false;
+#endif
+        }
+
+    }  // namespace Simd
+
+}  // namespace Maze
@@ -0,0 +1,276 @@
+#include <Maze/Snapshot.hpp>
+#include <cstring>
+#include <fstream>
+#include "JsonParser.hpp"
+#include "MappedFile.hpp"
+#include "SnapshotWriter.hpp"
+
+namespace Maze {
+
+    namespace {
+
+        uint32_t read32(const uint8_t* data) {
+            uint32_t value;
+            std::memcpy(&value, data, sizeof(value));
+
+            return value;
+        }
+
+        uint64_t read64(const uint8_t* data) {
+            uint64_t value;
+            std::memcpy(&value, data, sizeof(value));
+
+            return value;
+        }
+
+    }  // namespace
+
+#pragma region SnapshotView
+
+    SnapshotView::SnapshotView(const uint8_t* data, size_t size, size_t slot, std::string_view key)
+        : _data(data), _size(size), _slot(slot), _key(key) {
+        if (slot > size || size - slot < SnapshotFormat::slot_size || _data[slot] > (uint8_t)Type::Object)
+            fail();
+    }
+
+    Type SnapshotView::get_type() const {
+        if (_slot == 0)
+            return Type::Null;
+
+        return (Type)_data[_slot];
+    }
+
+    bool SnapshotView::get_bool(bool fallback_value) const {
+        if (get_type() == Type::Bool)
+            return read_count() != 0;
+
+        return fallback_value;
+    }
+
+    int SnapshotView::get_int(int fallback_value) const {
+        if (get_type() == Type::Int)
+            return (int)read_count();
+
+        return fallback_value;
+    }
+
+    double SnapshotView::get_double(double fallback_value) const {
+        if (get_type() == Type::Double) {
+            const uint64_t bits = read_offset();
+            double value;
+            std::memcpy(&value, &bits, sizeof(value));
+
+            return value;
+        }
+
+        return fallback_value;
+    }
+
+    std::string_view SnapshotView::get_string(std::string_view fallback_value) const {
+        if (get_type() == Type::String)
+            return read_string(read_offset(), read_count());
+
+        return fallback_value;
+    }
+
+    size_t SnapshotView::count_children() const {
+        const Type type = get_type();
+
+        if (type == Type::Array || type == Type::Object)
+            return read_count();
+
+        return 0;
+    }
+
+    SnapshotView SnapshotView::get(int index) const {
+        if (index >= 0 && (size_t)index < count_children())
+            return get_child(index);
+
+        return SnapshotView();
+    }
+
+    SnapshotView SnapshotView::get(std::string_view key) const {
+        if (get_type() != Type::Object)
+            return SnapshotView();
+
+        const size_t count = read_count();
+        const uint64_t block = read_offset();
+        const uint64_t keys = block + count * SnapshotFormat::slot_size;
+        const uint64_t sorted = keys + count * SnapshotFormat::key_entry_size;
+
+        if (block > _size || sorted > _size || (_size - sorted) / sizeof(uint32_t) < count)
+            fail();
+
+        // Binary search over the key indices in sorted order
+        size_t low = 0;
+        size_t high = count;
+        while (low < high) {
+            const size_t middle = low + (high - low) / 2;
+            const uint32_t index = read32(_data + sorted + middle * sizeof(uint32_t));
+            if (index >= count)
+                fail();
+
+            const uint8_t* entry = _data + keys + index * SnapshotFormat::key_entry_size;
+            const std::string_view middle_key = read_string(read64(entry), read32(entry + 8));
+
+            if (middle_key < key) {
+                low = middle + 1;
+            }
+            else if (key < middle_key) {
+                high = middle;
+            }
+            else {
+                return SnapshotView(_data, _size, block + index * SnapshotFormat::slot_size, middle_key);
+            }
+        }
+
+        return SnapshotView();
+    }
+
+    bool SnapshotView::exists(std::string_view key) const {
+        return get(key)._slot != 0;
+    }
+
+    Element SnapshotView::to_element() const {
+        return to_element(0);
+    }
+
+    Element SnapshotView::to_element(int depth) const {
+        // Offsets of a corrupt snapshot can point back at a parent
+        if (depth > JsonParser::max_depth)
+            throw MazeException("Unable to read snapshot: maximum nesting depth exceeded");
+
+        switch (get_type()) {
+        case Type::Bool:
+            return Element(get_bool());
+        case Type::Int:
+            return Element(get_int());
+        case Type::Double:
+            return Element(get_double());
+        case Type::String:
+            return Element(get_string());
+        case Type::Array: {
+            Element result(Type::Array);
+            result.reserve(count_children());
+
+            for (const SnapshotView& child : *this) {
+                result.push_back(child.to_element(depth + 1));
+            }
+            return result;
+        }
+        case Type::Object: {
+            Element result(Type::Object);
+            result.reserve(count_children());
+
+            for (const SnapshotView& child : *this) {
+                result.set(child.get_key(), child.to_element(depth + 1));
+            }
+            return result;
+        }
+        default:
+            return Element();
+        }
+    }
+
+    SnapshotView SnapshotView::get_child(size_t index) const {
+        const size_t count = read_count();
+        const uint64_t block = read_offset();
+        if (block > _size)
+            fail();
+
+        const uint64_t slot = block + index * SnapshotFormat::slot_size;
+
+        if (get_type() == Type::Array)
+            return SnapshotView(_data, _size, slot);
+
+        const uint64_t entry = block + count * SnapshotFormat::slot_size + index * SnapshotFormat::key_entry_size;
+        if (entry > _size || _size - entry < SnapshotFormat::key_entry_size)
+            fail();
+
+        return SnapshotView(_data, _size, slot, read_string(read64(_data + entry), read32(_data + entry + 8)));
+    }
+
+    uint32_t SnapshotView::read_count() const {
+        return read32(_data + _slot + 4);
+    }
+
+    uint64_t SnapshotView::read_offset() const {
+        return read64(_data + _slot + 8);
+    }
+
+    std::string_view SnapshotView::read_string(uint64_t offset, uint32_t length) const {
+        if (offset > _size || _size - offset < length)
+            fail();
+
+        return std::string_view((const char*)_data + offset, length);
+    }
+
+    void SnapshotView::fail() const {
+        throw MazeException("Unable to read snapshot: value out of bounds");
+    }
+
+#pragma endregion
+
+#pragma region Snapshot
+
+    Snapshot::Snapshot(std::vector<uint8_t> data)
+        : _buffer(std::move(data)) {
+        _data = _buffer.data();
+        _size = _buffer.size();
+
+        check_header();
+    }
+
+    Snapshot::Snapshot(Snapshot&& other) noexcept = default;
+    Snapshot& Snapshot::operator=(Snapshot&& other) noexcept = default;
+    Snapshot::~Snapshot() = default;
+
+    Snapshot Snapshot::open_file(const std::string& path) {
+        Snapshot snapshot;
+        snapshot._file = std::make_unique<MappedFile>(path);
+        snapshot._data = (const uint8_t*)snapshot._file->data();
+        snapshot._size = snapshot._file->size();
+
+        snapshot.check_header();
+
+        return snapshot;
+    }
+
+    std::vector<uint8_t> Snapshot::write(const Element& el) {
+        std::vector<uint8_t> output;
+        SnapshotWriter(output).write(el);
+
+        return output;
+    }
+
+    void Snapshot::write_file(const Element& el, const std::string& path) {
+        const std::vector<uint8_t> data = write(el);
+
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file)
+            throw MazeException("Unable to open file " + path);
+
+        file.write((const char*)data.data(), data.size());
+        if (!file)
+            throw MazeException("Unable to write file " + path);
+    }
+
+    SnapshotView Snapshot::root() const {
+        return SnapshotView(_data, _size, SnapshotFormat::root_slot);
+    }
+
+    void Snapshot::check_header() const {
+        if (_size < SnapshotFormat::header_size + SnapshotFormat::slot_size
+            || std::memcmp(_data, SnapshotFormat::magic, sizeof(SnapshotFormat::magic)) != 0)
+            throw MazeException("Unable to read snapshot: not a Maze snapshot");
+
+        if (read32(_data + 12) != SnapshotFormat::byte_order_mark)
+            throw MazeException("Unable to read snapshot: written with a different byte order");
+
+        if (read32(_data + 8) != SnapshotFormat::version)
+            throw MazeException("Unable to read snapshot: unsupported version " + std::to_string(read32(_data + 8)));
+    }
+
+#pragma endregion
+
+}  // namespace Maze
@@ -0,0 +1,141 @@
+#include "SnapshotWriter.hpp"
+#include "KeyTable.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace Maze {
+
+    SnapshotWriter::SnapshotWriter(std::vector<uint8_t>& output)
+        : _out(output) {}
+
+    void SnapshotWriter::write(const Element& el) {
+        _out.clear();
+        _key_offsets.clear();
+
+        allocate(SnapshotFormat::header_size + SnapshotFormat::slot_size);
+        std::memcpy(_out.data(), SnapshotFormat::magic, sizeof(SnapshotFormat::magic));
+        put32(8, SnapshotFormat::version);
+        put32(12, SnapshotFormat::byte_order_mark);
+
+        write_slot(SnapshotFormat::root_slot, el);
+    }
+
+    void SnapshotWriter::write_slot(size_t slot, const Element& el) {
+        const Type type = el.get_type() == Type::Function ? Type::Null : el.get_type();
+        _out[slot] = (uint8_t)type;
+
+        switch (type) {
+        case Type::Bool:
+            put32(slot + 4, el._val_bool ? 1 : 0);
+            break;
+        case Type::Int:
+            put32(slot + 4, (uint32_t)el._val_int);
+            break;
+        case Type::Double: {
+            uint64_t bits;
+            std::memcpy(&bits, &el._val_double, sizeof(bits));
+
+            put64(slot + 8, bits);
+            break;
+        }
+        case Type::String: {
+            const size_t offset = write_string(el._val_string);
+
+            put32(slot + 4, (uint32_t)el._val_string.size());
+            put64(slot + 8, offset);
+            break;
+        }
+        case Type::Array:
+            write_array(slot, el);
+            break;
+        case Type::Object:
+            write_object(slot, el);
+            break;
+        default:
+            break;
+        }
+    }
+
+    void SnapshotWriter::write_array(size_t slot, const Element& el) {
+        const Element::ChildVector& values = el.get_storage().values;
+        check_count(values.size());
+
+        const size_t block = allocate(values.size() * SnapshotFormat::slot_size);
+
+        put32(slot + 4, (uint32_t)values.size());
+        put64(slot + 8, block);
+
+        for (size_t i = 0; i < values.size(); ++i) {
+            write_slot(block + i * SnapshotFormat::slot_size, values[i]);
+        }
+    }
+
+    void SnapshotWriter::write_object(size_t slot, const Element& el) {
+        const Element::Children& children = el.get_storage();
+        const size_t count = children.values.size();
+        check_count(count);
+
+        const size_t keys = count * SnapshotFormat::slot_size;
+        const size_t sorted = keys + count * SnapshotFormat::key_entry_size;
+        const size_t block = allocate(sorted + count * sizeof(uint32_t));
+
+        put32(slot + 4, (uint32_t)count);
+        put64(slot + 8, block);
+
+        std::vector<uint32_t> order(count);
+        for (size_t i = 0; i < count; ++i) {
+            const std::string& key = KeyTable::get(children.keys[i].id());
+
+            auto it = _key_offsets.find(children.keys[i].id());
+            if (it == _key_offsets.end())
+                it = _key_offsets.emplace(children.keys[i].id(), write_string(key)).first;
+
+            put64(block + keys + i * SnapshotFormat::key_entry_size, it->second);
+            put32(block + keys + i * SnapshotFormat::key_entry_size + 8, (uint32_t)key.size());
+            order[i] = (uint32_t)i;
+        }
+
+        std::sort(order.begin(), order.end(), [&children](uint32_t a, uint32_t b) {
+            return KeyTable::get(children.keys[a].id()) < KeyTable::get(children.keys[b].id());
+        });
+        for (size_t i = 0; i < count; ++i) {
+            put32(block + sorted + i * sizeof(uint32_t), order[i]);
+        }
+
+        for (size_t i = 0; i < count; ++i) {
+            write_slot(block + i * SnapshotFormat::slot_size, children.values[i]);
+        }
+    }
+
+    void SnapshotWriter::check_count(size_t count) {
+        if (count > UINT32_MAX)
+            throw MazeException("Unable to write snapshot: container of " + std::to_string(count) + " children is too large");
+    }
+
+    size_t SnapshotWriter::write_string(std::string_view value) {
+        if (value.size() > UINT32_MAX)
+            throw MazeException("Unable to write snapshot: string of " + std::to_string(value.size()) + " bytes is too long");
+
+        const size_t offset = allocate(value.size() + 1);
+        std::memcpy(_out.data() + offset, value.data(), value.size());
+
+        return offset;
+    }
+
+    // Appends zeroed space aligned to 8 bytes and returns its offset
+    size_t SnapshotWriter::allocate(size_t size) {
+        const size_t offset = (_out.size() + 7) & ~(size_t)7;
+        _out.resize(offset + size);
+
+        return offset;
+    }
+
+    void SnapshotWriter::put32(size_t offset, uint32_t value) {
+        std::memcpy(_out.data() + offset, &value, sizeof(value));
+    }
+
+    void SnapshotWriter::put64(size_t offset, uint64_t value) {
+        std::memcpy(_out.data() + offset, &value, sizeof(value));
+    }
+
+}  // namespace Maze
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <Maze/Maze.hpp>
+
+namespace Maze {
+
+    // Layout shared by the snapshot writer and views. All numbers are in native
+    // byte order, which the header records so foreign snapshots are rejected.
+    //
+    // Header:  8 byte magic, uint32 version, uint32 byte order mark
+    // Slot:    uint8 type, 3 unused bytes, uint32 a, uint64 b (16 bytes)
+    //          Bool and Int store their value in a, Double its bits in b.
+    //          String, Array and Object store a length or count in a and the
+    //          offset of their data in b.
+    // Array:   count slots
+    // Object:  count slots, count key entries of (uint64 offset, uint32 length,
+    //          4 unused bytes), count uint32 indices of keys in sorted order
+    // Strings are NUL terminated. The root slot follows the header.
+    namespace SnapshotFormat {
+
+        const char magic[8] = { 'M', 'A', 'Z', 'E', 'S', 'N', 'A', 'P' };
+        const uint32_t version = 1;
+        const uint32_t byte_order_mark = 0x01020304;
+
+        const size_t header_size = 16;
+        const size_t slot_size = 16;
+        const size_t key_entry_size = 16;
+        const size_t root_slot = header_size;
+
+    }  // namespace SnapshotFormat
+
+    class SnapshotWriter {
+    public:
+        explicit SnapshotWriter(std::vector<uint8_t>& output);
+
+        void write(const Element& el);
+
+    private:
+        void write_slot(size_t slot, const Element& el);
+        void write_array(size_t slot, const Element& el);
+        void write_object(size_t slot, const Element& el);
+        void check_count(size_t count);
+        size_t write_string(std::string_view value);
+        size_t allocate(size_t size);
+
+        void put32(size_t offset, uint32_t value);
+        void put64(size_t offset, uint64_t value);
+
+        std::vector<uint8_t>& _out;
+
+        // Keys repeat across objects, each one is stored once
+        std::unordered_map<uint32_t, size_t> _key_offsets;
+    };
+
+}  // namespace Maze
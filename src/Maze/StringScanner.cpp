@@ -0,0 +1,302 @@
+#include "StringScanner.hpp"
+#include "Simd.hpp"
+
+namespace Maze {
+
+    namespace {
+
+        inline bool is_special(unsigned char c) {
+            return c == '"' || c == '\\' || c < 0x20 || c >= 0x80;
+        }
+
+        const char* find_special_scalar(const char* pos, const char* end) {
+            while (pos != end && !is_special((unsigned char)*pos))
+                ++pos;
+
+            return pos;
+        }
+
+#ifdef MAZE_SIMD_SSE2
+        const char* find_special_sse2(const char* pos, const char* end) {
+            const __m128i quote = _mm_set1_epi8('"');
+            const __m128i backslash = _mm_set1_epi8('\\');
+            const __m128i control_max = _mm_set1_epi8(0x1F);
+
+            for (; end - pos >= 16; pos += 16) {
+                const __m128i chunk = _mm_loadu_si128((const __m128i*)pos);
+
+                // Unsigned min equals the byte only for control characters, non ASCII bytes are the sign bits
+                const __m128i special = _mm_or_si128(
+                    _mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash)),
+                    _mm_cmpeq_epi8(_mm_min_epu8(chunk, control_max), chunk));
+                const unsigned int mask = (unsigned int)_mm_movemask_epi8(_mm_or_si128(special, chunk));
+
+                if (mask != 0)
+                    return pos + Simd::count_trailing_zeros(mask);
+            }
+
+            return find_special_scalar(pos, end);
+        }
+#endif
+
+#ifdef MAZE_SIMD_AVX2
+        MAZE_SIMD_TARGET_AVX2
+        const char* find_special_avx2(const char* pos, const char* end) {
+            const __m256i quote = _mm256_set1_epi8('"');
+            const __m256i backslash = _mm256_set1_epi8('\\');
+            const __m256i control_max = _mm256_set1_epi8(0x1F);
+
+            for (; end - pos >= 32; pos += 32) {
+                const __m256i chunk = _mm256_loadu_si256((const __m256i*)pos);
+
+                const __m256i special = _mm256_or_si256(
+                    _mm256_or_si256(_mm256_cmpeq_epi8(chunk, quote), _mm256_cmpeq_epi8(chunk, backslash)),
+                    _mm256_cmpeq_epi8(_mm256_min_epu8(chunk, control_max), chunk));
+                const unsigned int mask = (unsigned int)_mm256_movemask_epi8(_mm256_or_si256(special, chunk));
+
+                if (mask != 0)
+                    return pos + Simd::count_trailing_zeros(mask);
+            }
+
+            return find_special_scalar(pos, end);
+        }
+#endif
+
+        using FindSpecial = const char* (*)(const char*, const char*);
+
+        FindSpecial select_find_special() {
+#ifdef MAZE_SIMD_AVX2
+            if (Simd::has_avx2())
+                return find_special_avx2;
+#endif
+#ifdef MAZE_SIMD_SSE2
+            return find_special_sse2;
+#else
+            return find_special_scalar;
+#endif
+        }
+
+        // Length of the valid UTF-8 sequence starting at pos, 0 if it is invalid
+        int utf8_sequence_length(const char* pos, const char* end) {
+            const unsigned char c = (unsigned char)*pos;
+            int length;
+            unsigned int code_point;
+
+            if ((c & 0xE0) == 0xC0) {
+                length = 2;
+                code_point = c & 0x1F;
+            }
+            else if ((c & 0xF0) == 0xE0) {
+                length = 3;
+                code_point = c & 0x0F;
+            }
+            else if ((c & 0xF8) == 0xF0) {
+                length = 4;
+                code_point = c & 0x07;
+            }
+            else {
+                return 0;
+            }
+
+            if (end - pos < length)
+                return 0;
+
+            for (int i = 1; i < length; ++i) {
+                const unsigned char continuation = (unsigned char)pos[i];
+
+                if ((continuation & 0xC0) != 0x80)
+                    return 0;
+
+                code_point = (code_point << 6) | (continuation & 0x3F);
+            }
+
+            if ((length == 2 && code_point < 0x80) ||
+                (length == 3 && code_point < 0x800) ||
+                (length == 4 && (code_point < 0x10000 || code_point > 0x10FFFF)) ||
+                (code_point >= 0xD800 && code_point <= 0xDFFF))
+                return 0;
+
+            return length;
+        }
+
+        // Skips valid UTF-8 text up to the next quote, backslash or control character,
+        // ASCII runs go through find_special and multi byte sequences are checked one by one
+        const char* skip_utf8_generic(const char* pos, const char* end) {
+            while (pos != end) {
+                if ((unsigned char)*pos < 0x80) {
+                    pos = StringScanner::find_special(pos, end);
+                    if (pos == end || (unsigned char)*pos < 0x80)
+                        break;
+                }
+
+                const int length = utf8_sequence_length(pos, end);
+                if (length == 0)
+                    break;
+
+                pos += length;
+            }
+
+            return pos;
+        }
+
+        // First character boundary at or before pos, given that [begin, pos) held no invalid sequence.
+        // Backs up three bytes so a lead byte whose sequence pos cuts short is included.
+        const char* sequence_start(const char* begin, const char* pos) {
+            pos = pos - begin > 3 ? pos - 3 : begin;
+
+            while (pos != begin && ((unsigned char)*pos & 0xC0) == 0x80)
+                --pos;
+
+            return pos;
+        }
+
+#ifdef MAZE_SIMD_AVX2
+        // UTF-8 validation by Keiser and Lemire, "Validating UTF-8 In Less Than One Instruction Per Byte".
+        // Three nibble lookups flag every invalid pair of adjacent bytes, a saturated subtraction
+        // marks the bytes that must be the third or fourth byte of a sequence.
+        constexpr uint8_t too_short = 1 << 0;       // Lead byte followed by a lead or ASCII byte
+        constexpr uint8_t too_long = 1 << 1;        // ASCII followed by a continuation
+        constexpr uint8_t overlong_3 = 1 << 2;      // E0 80..9F
+        constexpr uint8_t too_large = 1 << 3;       // F4 90..BF and F5..FF
+        constexpr uint8_t surrogate = 1 << 4;       // ED A0..BF
+        constexpr uint8_t overlong_2 = 1 << 5;      // C0 and C1
+        constexpr uint8_t too_large_1000 = 1 << 6;  // F5..FF 80..8F
+        constexpr uint8_t overlong_4 = 1 << 6;      // F0 80..8F
+        constexpr uint8_t two_conts = 1 << 7;       // Continuation after continuation, valid only where expected
+        constexpr uint8_t carry = too_short | too_long | two_conts;
+
+        alignas(16) constexpr uint8_t byte_1_high_table[16] = {
+            too_long, too_long, too_long, too_long, too_long, too_long, too_long, too_long,
+            two_conts, two_conts, two_conts, two_conts,
+            too_short | overlong_2,
+            too_short,
+            too_short | overlong_3 | surrogate,
+            too_short | too_large | too_large_1000 | overlong_4
+        };
+
+        alignas(16) constexpr uint8_t byte_1_low_table[16] = {
+            carry | overlong_3 | overlong_2 | overlong_4,
+            carry | overlong_2,
+            carry,
+            carry,
+            carry | too_large,
+            carry | too_large | too_large_1000,
+            carry | too_large | too_large_1000,
+            carry | too_large | too_large_1000,
+            carry | too_large | too_large_1000,
+            carry | too_large | too_large_1000,
+            carry | too_large | too_large_1000,
+            carry | too_large | too_large_1000,
+            carry | too_large | too_large_1000,
+            carry | too_large | too_large_1000 | surrogate,
+            carry | too_large | too_large_1000,
+            carry | too_large | too_large_1000
+        };
+
+        alignas(16) constexpr uint8_t byte_2_high_table[16] = {
+            too_short, too_short, too_short, too_short, too_short, too_short, too_short, too_short,
+            too_long | overlong_2 | two_conts | overlong_3 | too_large_1000 | overlong_4,
+            too_long | overlong_2 | two_conts | overlong_3 | too_large,
+            too_long | overlong_2 | two_conts | surrogate | too_large,
+            too_long | overlong_2 | two_conts | surrogate | too_large,
+            too_short, too_short, too_short, too_short
+        };
+
+        MAZE_SIMD_TARGET_AVX2
+        inline __m256i load_table(const uint8_t (&table)[16]) {
+            return _mm256_broadcastsi128_si256(_mm_load_si128((const __m128i*)table));
+        }
+
+        MAZE_SIMD_TARGET_AVX2
+        inline __m256i high_nibbles(__m256i value) {
+            return _mm256_and_si256(_mm256_srli_epi16(value, 4), _mm256_set1_epi8(0x0F));
+        }
+
+        MAZE_SIMD_TARGET_AVX2
+        const char* skip_utf8_avx2(const char* pos, const char* end) {
+            const char* begin = pos;
+            const __m256i byte_1_high = load_table(byte_1_high_table);
+            const __m256i byte_1_low = load_table(byte_1_low_table);
+            const __m256i byte_2_high = load_table(byte_2_high_table);
+            const __m256i low_nibble_mask = _mm256_set1_epi8(0x0F);
+            const __m256i quote = _mm256_set1_epi8('"');
+            const __m256i backslash = _mm256_set1_epi8('\\');
+            const __m256i control_max = _mm256_set1_epi8(0x1F);
+
+            // pos is a character boundary, so the text before it acts like ASCII
+            __m256i previous = _mm256_setzero_si256();
+
+            for (; end - pos >= 32; pos += 32) {
+                const __m256i chunk = _mm256_loadu_si256((const __m256i*)pos);
+
+                // Byte i of prevN is the byte N positions before byte i of chunk
+                const __m256i carried = _mm256_permute2x128_si256(previous, chunk, 0x21);
+                const __m256i prev1 = _mm256_alignr_epi8(chunk, carried, 15);
+                const __m256i prev2 = _mm256_alignr_epi8(chunk, carried, 14);
+                const __m256i prev3 = _mm256_alignr_epi8(chunk, carried, 13);
+
+                const __m256i special_cases = _mm256_and_si256(
+                    _mm256_and_si256(
+                        _mm256_shuffle_epi8(byte_1_high, high_nibbles(prev1)),
+                        _mm256_shuffle_epi8(byte_1_low, _mm256_and_si256(prev1, low_nibble_mask))),
+                    _mm256_shuffle_epi8(byte_2_high, high_nibbles(chunk)));
+
+                // Sign bit set where two or three bytes back is a lead byte of a three or four byte sequence
+                const __m256i must_be_continuation = _mm256_and_si256(
+                    _mm256_or_si256(
+                        _mm256_subs_epu8(prev2, _mm256_set1_epi8(0xE0 - 0x80)),
+                        _mm256_subs_epu8(prev3, _mm256_set1_epi8(0xF0 - 0x80))),
+                    _mm256_set1_epi8((char)0x80));
+
+                const __m256i error = _mm256_xor_si256(must_be_continuation, special_cases);
+                const __m256i special = _mm256_or_si256(
+                    _mm256_or_si256(_mm256_cmpeq_epi8(chunk, quote), _mm256_cmpeq_epi8(chunk, backslash)),
+                    _mm256_cmpeq_epi8(_mm256_min_epu8(chunk, control_max), chunk));
+
+                const unsigned int error_mask = ~(unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(error, _mm256_setzero_si256()));
+                const unsigned int special_mask = (unsigned int)_mm256_movemask_epi8(special);
+
+                if ((error_mask | special_mask) != 0) {
+                    const unsigned int error_index = error_mask != 0 ? Simd::count_trailing_zeros(error_mask) : 32;
+                    const unsigned int special_index = special_mask != 0 ? Simd::count_trailing_zeros(special_mask) : 32;
+
+                    if (special_index < error_index)
+                        return pos + special_index;
+
+                    // The invalid sequence starts at most three bytes before the flagged byte
+                    return skip_utf8_generic(sequence_start(begin, pos + error_index), end);
+                }
+
+                previous = chunk;
+            }
+
+            // The last block may end inside a sequence, finish it and the tail one by one
+            return skip_utf8_generic(sequence_start(begin, pos), end);
+        }
+#endif
+
+        using SkipUtf8 = const char* (*)(const char*, const char*);
+
+        SkipUtf8 select_skip_utf8() {
+#ifdef MAZE_SIMD_AVX2
+            if (Simd::has_avx2())
+                return skip_utf8_avx2;
+#endif
+            return skip_utf8_generic;
+        }
+
+    }  // namespace
+
+    const char* StringScanner::find_special(const char* pos, const char* end) {
+        static const FindSpecial find_special_impl = select_find_special();
+
+        return find_special_impl(pos, end);
+    }
+
+    const char* StringScanner::skip_utf8(const char* pos, const char* end) {
+        static const SkipUtf8 skip_utf8_impl = select_skip_utf8();
+
+        return skip_utf8_impl(pos, end);
+    }
+
+}  // namespace Maze
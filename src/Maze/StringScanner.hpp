@@ -0,0 +1,20 @@
+#pragma once
+
+namespace Maze {
+
+    // Scans the contents of JSON strings. Plain ASCII is skipped 16 or 32 bytes
+    // at a time with SSE2 or AVX2, picked once at runtime. With AVX2, UTF-8 is
+    // validated 32 bytes at a time as well, otherwise multi byte sequences are
+    // checked one by one between the vectorized ASCII runs.
+    class StringScanner {
+    public:
+        // Returns the first quote, backslash, control or non ASCII byte, or end
+        static const char* find_special(const char* pos, const char* end);
+
+        // Skips valid UTF-8 text, ASCII included, starting at a character boundary. Stops at
+        // the first quote, backslash or control character, or at the start of an invalid
+        // or truncated sequence.
+        static const char* skip_utf8(const char* pos, const char* end);
+    };
+
+}  // namespace Maze
@@ -0,0 +1,214 @@
+#include <Maze/StructuralIndex.hpp>
+#include <cstring>
+#include "Simd.hpp"
+
+namespace Maze {
+
+    namespace {
+
+        // Bit i of the result is the parity of bits 0 to i, turning quote bits into string masks
+        inline uint64_t prefix_xor(uint64_t bits) {
+            bits ^= bits << 1;
+            bits ^= bits << 2;
+            bits ^= bits << 4;
+            bits ^= bits << 8;
+            bits ^= bits << 16;
+            bits ^= bits << 32;
+
+            return bits;
+        }
+
+        // Finds the characters escaped by a backslash. A run of backslashes escapes every
+        // other character, runs starting on odd bits are shifted into place by the carry
+        // of an addition. escaped_carry holds an escape that spills into the next block.
+        inline uint64_t find_escaped(uint64_t backslash, uint64_t& escaped_carry) {
+            const uint64_t even_bits = 0x5555555555555555ull;
+
+            backslash &= ~escaped_carry;
+            const uint64_t follows_escape = backslash << 1 | escaped_carry;
+
+            const uint64_t odd_sequence_starts = backslash & ~even_bits & ~follows_escape;
+            const uint64_t sequences_starting_on_even_bits = odd_sequence_starts + backslash;
+            escaped_carry = sequences_starting_on_even_bits < odd_sequence_starts ? 1 : 0;
+
+            const uint64_t invert_mask = sequences_starting_on_even_bits << 1;
+
+            return (even_bits ^ invert_mask) & follows_escape;
+        }
+
+        inline void index_block(uint64_t quote, uint64_t backslash, uint64_t op, uint32_t base,
+            uint64_t& in_string, uint64_t& escaped, std::vector<uint32_t>& positions) {
+            quote &= ~find_escaped(backslash, escaped);
+
+            const uint64_t string_mask = prefix_xor(quote) ^ in_string;
+            in_string = (uint64_t)((int64_t)string_mask >> 63);
+
+            uint64_t structurals = (op & ~string_mask) | (quote & string_mask);
+            while (structurals != 0) {
+                positions.push_back(base + Simd::count_trailing_zeros(structurals));
+                structurals &= structurals - 1;
+            }
+        }
+
+        void scan_scalar(const char* data, uint32_t size, uint64_t& in_string, uint64_t& escaped, std::vector<uint32_t>& positions) {
+            // Backslashes escape quotes outside of strings as well, like in the vector paths
+            for (uint32_t i = 0; i < size; ++i) {
+                const char c = data[i];
+                const bool is_escaped = escaped != 0;
+                escaped = c == '\\' && !is_escaped ? 1 : 0;
+
+                if (c == '"') {
+                    if (is_escaped)
+                        continue;
+
+                    in_string = ~in_string;
+                    if (in_string)
+                        positions.push_back(i);
+                }
+                else if (!in_string && (c == '{' || c == '}' || c == '[' || c == ']' || c == ':' || c == ',')) {
+                    positions.push_back(i);
+                }
+            }
+        }
+
+#ifdef MAZE_SIMD_SSE2
+        void scan_sse2(const char* data, uint32_t size, uint64_t& in_string, uint64_t& escaped, std::vector<uint32_t>& positions) {
+            const __m128i quote_char = _mm_set1_epi8('"');
+            const __m128i backslash_char = _mm_set1_epi8('\\');
+            const __m128i case_bit = _mm_set1_epi8(0x20);
+            const __m128i open_brace = _mm_set1_epi8('{');
+            const __m128i close_brace = _mm_set1_epi8('}');
+            const __m128i colon = _mm_set1_epi8(':');
+            const __m128i comma = _mm_set1_epi8(',');
+
+            char padded[64];
+
+            for (uint32_t i = 0; i < size; i += 64) {
+                const char* block = data + i;
+                if (size - i < 64) {
+                    std::memset(padded, ' ', sizeof(padded));
+                    std::memcpy(padded, block, size - i);
+                    block = padded;
+                }
+
+                uint64_t quote = 0;
+                uint64_t backslash = 0;
+                uint64_t op = 0;
+
+                for (int j = 0; j < 4; ++j) {
+                    const __m128i chunk = _mm_loadu_si128((const __m128i*)(block + j * 16));
+
+                    // Brackets differ from braces only in the 0x20 bit
+                    const __m128i folded = _mm_or_si128(chunk, case_bit);
+                    const __m128i ops = _mm_or_si128(
+                        _mm_or_si128(_mm_cmpeq_epi8(folded, open_brace), _mm_cmpeq_epi8(folded, close_brace)),
+                        _mm_or_si128(_mm_cmpeq_epi8(chunk, colon), _mm_cmpeq_epi8(chunk, comma)));
+
+                    quote |= (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, quote_char)) << (j * 16);
+                    backslash |= (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, backslash_char)) << (j * 16);
+                    op |= (uint64_t)(uint16_t)_mm_movemask_epi8(ops) << (j * 16);
+                }
+
+                index_block(quote, backslash, op, i, in_string, escaped, positions);
+            }
+        }
+#endif
+
+#ifdef MAZE_SIMD_AVX2
+        MAZE_SIMD_TARGET_AVX2
+        void scan_avx2(const char* data, uint32_t size, uint64_t& in_string, uint64_t& escaped, std::vector<uint32_t>& positions) {
+            const __m256i quote_char = _mm256_set1_epi8('"');
+            const __m256i backslash_char = _mm256_set1_epi8('\\');
+            const __m256i case_bit = _mm256_set1_epi8(0x20);
+            const __m256i open_brace = _mm256_set1_epi8('{');
+            const __m256i close_brace = _mm256_set1_epi8('}');
+            const __m256i colon = _mm256_set1_epi8(':');
+            const __m256i comma = _mm256_set1_epi8(',');
+
+            char padded[64];
+
+            for (uint32_t i = 0; i < size; i += 64) {
+                const char* block = data + i;
+                if (size - i < 64) {
+                    std::memset(padded, ' ', sizeof(padded));
+                    std::memcpy(padded, block, size - i);
+                    block = padded;
+                }
+
+                uint64_t quote = 0;
+                uint64_t backslash = 0;
+                uint64_t op = 0;
+
+                for (int j = 0; j < 2; ++j) {
+                    const __m256i chunk = _mm256_loadu_si256((const __m256i*)(block + j * 32));
+
+                    const __m256i folded = _mm256_or_si256(chunk, case_bit);
+                    const __m256i ops = _mm256_or_si256(
+                        _mm256_or_si256(_mm256_cmpeq_epi8(folded, open_brace), _mm256_cmpeq_epi8(folded, close_brace)),
+                        _mm256_or_si256(_mm256_cmpeq_epi8(chunk, colon), _mm256_cmpeq_epi8(chunk, comma)));
+
+                    quote |= (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, quote_char)) << (j * 32);
+                    backslash |= (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, backslash_char)) << (j * 32);
+                    op |= (uint64_t)(uint32_t)_mm256_movemask_epi8(ops) << (j * 32);
+                }
+
+                index_block(quote, backslash, op, i, in_string, escaped, positions);
+            }
+        }
+#endif
+
+    }  // namespace
+
+    StructuralIndex::StructuralIndex(Implementation implementation)
+        : _implementation(is_supported(implementation) ? implementation : Implementation::Scalar) {}
+
+    StructuralIndex::Implementation StructuralIndex::best_implementation() {
+        static const Implementation best =
+            is_supported(Implementation::Avx2) ? Implementation::Avx2 :
+            is_supported(Implementation::Sse2) ? Implementation::Sse2 :
+            Implementation::Scalar;
+
+        return best;
+    }
+
+    bool StructuralIndex::is_supported(Implementation implementation) {
+        switch (implementation) {
+#ifdef MAZE_SIMD_SSE2
+        case Implementation::Sse2:
+            return true;
+#endif
+#ifdef MAZE_SIMD_AVX2
+        case Implementation::Avx2:
+            return Simd::has_avx2();
+#endif
+        case Implementation::Scalar:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    void StructuralIndex::scan(const char* data, uint32_t size, std::vector<uint32_t>& positions) {
+        switch (_implementation) {
+#ifdef MAZE_SIMD_SSE2
+        case Implementation::Sse2:
+            scan_sse2(data, size, _in_string, _escaped, positions);
+            break;
+#endif
+#ifdef MAZE_SIMD_AVX2
+        case Implementation::Avx2:
+            scan_avx2(data, size, _in_string, _escaped, positions);
+            break;
+#endif
+        default:
+            scan_scalar(data, size, _in_string, _escaped, positions);
+            break;
+        }
+    }
+
+    void StructuralIndex::reset() {
+        _in_string = 0;
+        _escaped = 0;
+    }
+
+}  // namespace Maze
@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+#include <Maze/Maze.hpp>
+#include <nlohmann/json.hpp>
+#include <climits>
+#include <cmath>
+#include "TestData.hpp"
+
+using Maze::Element;
+using Maze::Tests::sample_json;
+
+class CborTest : public ::testing::Test {};
+
+TEST_F(CborTest, RoundTrip) {
+	Element el = Element::from_json(sample_json);
+	el.set("long_text", Element(std::string(70000, 'x')));
+
+	Element decoded = Element::from_cbor(el.to_cbor());
+
+	EXPECT_EQ(decoded.to_json(-1), el.to_json(-1));
+	EXPECT_EQ(decoded["ints"][22].i(), INT_MIN);
+}
+
+TEST_F(CborTest, MatchesNlohmann) {
+	const nlohmann::json json = nlohmann::json::parse(sample_json);
+	Element el = Element::from_json(sample_json);
+
+	EXPECT_EQ(nlohmann::json::from_cbor(el.to_cbor()), json);
+	EXPECT_EQ(Element::from_cbor(nlohmann::json::to_cbor(json)).to_json(-1), json.dump());
+}
+
+TEST_F(CborTest, SmallestEncodings) {
+	EXPECT_EQ(Element(10).to_cbor(), std::vector<uint8_t>({ 0x0a }));
+	EXPECT_EQ(Element(-500).to_cbor(), std::vector<uint8_t>({ 0x39, 0x01, 0xf3 }));
+	EXPECT_EQ(Element(1.5).to_cbor(), std::vector<uint8_t>({ 0xfa, 0x3f, 0xc0, 0x00, 0x00 }));
+	EXPECT_EQ(Element("ab").to_cbor(), std::vector<uint8_t>({ 0x62, 'a', 'b' }));
+	EXPECT_EQ(Element(true).to_cbor(), std::vector<uint8_t>({ 0xf5 }));
+}
+
+TEST_F(CborTest, DoublesOutsideFloatRange) {
+	EXPECT_EQ(Element(1e300).to_cbor().size(), 9u);
+	EXPECT_EQ(Element::from_cbor(Element(-1e300).to_cbor()).d(), -1e300);
+	EXPECT_EQ(Element(INFINITY).to_cbor(), std::vector<uint8_t>({ 0xfa, 0x7f, 0x80, 0x00, 0x00 }));
+}
+
+TEST_F(CborTest, Decode_IndefiniteLengthsAndTags) {
+	// {_ "a": [_ 1, 2], "b": (_ "x", "yz")} with a tagged half float
+	const std::vector<uint8_t> input = {
+		0xbf,
+		0x61, 'a', 0x9f, 0x01, 0x02, 0xff,
+		0x61, 'b', 0x7f, 0x61, 'x', 0x62, 'y', 'z', 0xff,
+		0x61, 'c', 0xc1, 0xf9, 0x3e, 0x00,
+		0x61, 'd', 0xf7,
+		0xff
+	};
+
+	Element el = Element::from_cbor(input);
+
+	EXPECT_EQ(el.to_json(-1), R"({"a":[1,2],"b":"xyz","c":1.5,"d":null})");
+}
+
+TEST_F(CborTest, Decode_HalfFloats) {
+	EXPECT_EQ(Element::from_cbor({ 0xf9, 0x00, 0x01 }).d(), std::ldexp(1.0, -24));
+	EXPECT_EQ(Element::from_cbor({ 0xf9, 0xc4, 0x00 }).d(), -4.0);
+	EXPECT_TRUE(std::isinf(Element::from_cbor({ 0xf9, 0x7c, 0x00 }).d()));
+}
+
+TEST_F(CborTest, Invalid_Throws) {
+	const std::vector<std::vector<uint8_t>> inputs = {
+		{},
+		{ 0x1c },
+		{ 0x19, 0x01 },
+		{ 0x63, 'a', 'b' },
+		{ 0x82, 0x01 },
+		{ 0xa1, 0x01, 0x02 },
+		{ 0x9f, 0x01 },
+		{ 0x7f, 0x41, 'a', 0xff },
+		{ 0xf8, 0x20 },
+		{ 0x01, 0x02 },
+		{ 0x1f },
+	};
+
+	for (const auto& input : inputs) {
+		EXPECT_THROW(Element::from_cbor(input), Maze::MazeException);
+	}
+
+	EXPECT_THROW(Element::from_cbor(std::vector<uint8_t>(5000, 0x81)), Maze::MazeException);
+}
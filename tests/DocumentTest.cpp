@@ -0,0 +1,168 @@
+#include <gtest/gtest.h>
+#include <Maze/Document.hpp>
+#include <utility>
+
+using Maze::Document;
+using Maze::Element;
+
+class DocumentTest : public ::testing::Test {};
+
+namespace {
+
+	// Upstream resource that keeps track of how many bytes are still allocated
+	class CountingResource : public std::pmr::memory_resource {
+	public:
+		size_t allocated = 0;
+
+	protected:
+		void* do_allocate(size_t bytes, size_t alignment) override {
+			allocated += bytes;
+			return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+		}
+
+		void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+			allocated -= bytes;
+			std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+		}
+
+		bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+			return this == &other;
+		}
+	};
+
+}
+
+TEST_F(DocumentTest, Parse_AllocatesFromArena) {
+	Document doc;
+	Element& root = doc.parse(R"({ "list": [ 1, { "a": [] } ], "name": "maze" })");
+
+	EXPECT_EQ(root.get_resource(), doc.get_resource());
+	EXPECT_EQ(root["list"].get_resource(), doc.get_resource());
+	EXPECT_EQ(root["list"][1]["a"].get_resource(), doc.get_resource());
+	EXPECT_EQ(root["list"][1].get_key(), "");
+	EXPECT_EQ(root["name"].s(), "maze");
+	EXPECT_EQ(root.to_json(-1), R"({"list":[1,{"a":[]}],"name":"maze"})");
+}
+
+TEST_F(DocumentTest, Reset_ReleasesArena) {
+	CountingResource upstream;
+	{
+		Document doc(256, &upstream);
+
+		doc.parse(R"([ [1, 2, 3], [4, 5, 6], { "key": "value" } ])");
+		EXPECT_GT(upstream.allocated, 0);
+
+		doc.reset();
+		EXPECT_EQ(upstream.allocated, 0);
+		EXPECT_TRUE(doc.root().is_null());
+
+		doc.parse("[1]");
+		EXPECT_EQ(doc.root()[0].i(), 1);
+	}
+	EXPECT_EQ(upstream.allocated, 0);
+}
+
+TEST_F(DocumentTest, Build_ChildrenMoveIntoArena) {
+	Document doc;
+	Element& root = doc.set_root(Maze::Type::Object);
+
+	Element& list = root.emplace("list", Maze::Type::Array);
+	list << 1 << Element(Maze::Type::Object);
+	root.set("nested", Element::from_json(R"({ "a": [1, 2] })"));
+
+	Element created = doc.create(Maze::Type::Array);
+	created << "x";
+	root.set("created", std::move(created));
+
+	EXPECT_EQ(root.get_resource(), doc.get_resource());
+	EXPECT_EQ(root["list"].get_resource(), doc.get_resource());
+	EXPECT_EQ(root["list"][1].get_resource(), doc.get_resource());
+	EXPECT_EQ(root["nested"]["a"].get_resource(), doc.get_resource());
+	EXPECT_EQ(root["created"].get_resource(), doc.get_resource());
+	EXPECT_EQ(root.to_json(-1), R"({"list":[1,{}],"nested":{"a":[1,2]},"created":["x"]})");
+}
+
+TEST_F(DocumentTest, Copy_OutlivesDocument) {
+	Element copy;
+	{
+		Document doc;
+		doc.parse(R"({ "list": [1, 2, 3] })");
+
+		copy = doc.root();
+		EXPECT_NE(copy.get_resource(), doc.get_resource());
+		EXPECT_NE(copy["list"].get_resource(), doc.get_resource());
+	}
+
+	EXPECT_EQ(copy["list"][2].i(), 3);
+}
+
+TEST_F(DocumentTest, Move_ToHeapTree) {
+	Document doc;
+	doc.parse(R"({ "list": [1, 2, 3] })");
+
+	Element el(Maze::Type::Array);
+	el.push_back(doc.root().take("list"));
+	doc.reset();
+
+	EXPECT_EQ(el[0].get_resource(), std::pmr::get_default_resource());
+	EXPECT_EQ(el.to_json(-1), "[[1,2,3]]");
+}
+
+TEST_F(DocumentTest, Parse_StringsAllocatedFromArena) {
+	Document doc;
+	CountingResource heap;
+	std::pmr::memory_resource* previous = std::pmr::set_default_resource(&heap);
+
+	Element& root = doc.parse(R"({ "text": "a string too long for the small string buffer", "list": [ "another string past sixteen characters" ] })");
+	std::pmr::set_default_resource(previous);
+
+	EXPECT_EQ(heap.allocated, 0);
+	EXPECT_EQ(std::as_const(root)["text"].get_resource(), doc.get_resource());
+	EXPECT_EQ(std::as_const(root)["list"][0].get_resource(), doc.get_resource());
+	EXPECT_EQ(root["list"][0].s(), "another string past sixteen characters");
+}
+
+TEST_F(DocumentTest, Build_StringsMoveIntoArena) {
+	Document doc;
+	Element& root = doc.set_root(Maze::Type::Object);
+	const std::string text(100, 'x');
+
+	root.set("text", text);
+	root.set("list", Element(Maze::Type::Array));
+	Element list = root.take("list");
+	list << text;
+	root.set("list", std::move(list));
+
+	EXPECT_EQ(std::as_const(root)["text"].get_resource(), doc.get_resource());
+	EXPECT_EQ(std::as_const(root)["list"][0].get_resource(), doc.get_resource());
+	EXPECT_EQ(std::as_const(root)["list"][0].s(), text);
+}
+
+TEST_F(DocumentTest, Reset_DestroysTreeOnlyWhenItHoldsOtherMemory) {
+	Document doc;
+	const Document::Arena& arena = *static_cast<Document::Arena*>(doc.get_resource());
+
+	// Built from parsed and moved in values only, the tree is left to the arena
+	doc.parse(R"({ "list": [ "a string too long for the small string buffer" ] })");
+	doc.root().set("more", Element::from_json(R"({ "a": [1, 2] })"));
+	EXPECT_FALSE(arena.holds_external());
+
+	// A reference may be used to store values allocated elsewhere
+	doc.root()["list"] = "another string past sixteen characters";
+	EXPECT_TRUE(arena.holds_external());
+
+	doc.reset();
+	EXPECT_FALSE(arena.holds_external());
+	EXPECT_TRUE(doc.root().is_null());
+
+	// Counted keys are released by destroying the tree
+	const std::string long_key(300, 'k');
+	doc.parse("{\"" + long_key + "\": 1}");
+	EXPECT_TRUE(arena.holds_external());
+	EXPECT_EQ(std::as_const(doc.root()).get(long_key).i(), 1);
+
+	doc.reset();
+	doc.parse(R"({ "key": "value" })");
+	EXPECT_FALSE(arena.holds_external());
+	EXPECT_EQ(doc.root().to_json(-1), R"({"key":"value"})");
+}
@@ -106,6 +106,52 @@ TEST_F(ElementArrayTest, PushBack) {
     EXPECT_EQ(el.get(0).s(), "val1");
 }
 
+TEST_F(ElementArrayTest, PushBack_Large) {
+    Maze::Element el(Maze::Type::Array);
+    for (int i = 0; i < 100000; ++i) {
+        el.push_back(i);
+    }
+
+    EXPECT_EQ(el.count_children(), 100000);
+    EXPECT_EQ(el[99999].i(), 99999);
+    EXPECT_EQ(el[99999].get_key(), "");
+    EXPECT_EQ(el.get_keys().back(), "~99999");
+}
+
+TEST_F(ElementArrayTest, PushBack_IntoObject_KeyClash) {
+    Maze::Element el(Maze::Type::Object);
+    el.set("~2", 42);
+
+    el.push_back("first");
+    EXPECT_THROW(el.push_back("second"), Maze::MazeException);
+}
+
+TEST_F(ElementArrayTest, Reserve) {
+    Maze::Element el(Maze::Type::Array);
+    EXPECT_EQ(el.capacity(), 0);
+
+    el.reserve(1000);
+    EXPECT_GE(el.capacity(), 1000);
+    EXPECT_EQ(el.count_children(), 0);
+
+    const size_t capacity = el.capacity();
+    for (int i = 0; i < 1000; ++i) {
+        el << i;
+    }
+    EXPECT_EQ(el.capacity(), capacity);
+
+    el.remove_all_children();
+    el.shrink_to_fit();
+    EXPECT_EQ(el.capacity(), 0);
+}
+
+TEST_F(ElementArrayTest, Reserve_NonArray_Throws) {
+    Maze::Element el(42);
+
+    EXPECT_THROW(el.reserve(10), Maze::MazeException);
+    EXPECT_EQ(el.capacity(), 0);
+}
+
 TEST_F(ElementArrayTest, GetRef_SetToNull) {
     EXPECT_EQ(arr_1.count_children(), 3);
     EXPECT_FALSE(arr_1.get(0).is_null());
@@ -158,6 +204,45 @@ TEST_F(ElementArrayTest, GetKeys) {
     EXPECT_EQ(arr_1.get_keys(), std::vector<std::string>({ "~0", "~1", "~2" }));
 }
 
+TEST_F(ElementArrayTest, GetKeys_FollowChildren) {
+    EXPECT_EQ(arr_1.get_keys().size(), 3);
+
+    arr_1 << "val4";
+    EXPECT_EQ(arr_1.get_keys(), std::vector<std::string>({ "~0", "~1", "~2", "~3" }));
+
+    arr_1.remove_at(0);
+    EXPECT_EQ(arr_1.get_keys(), std::vector<std::string>({ "~0", "~1", "~2" }));
+
+    arr_1.remove_all_children();
+    EXPECT_TRUE(arr_1.get_keys().empty());
+    EXPECT_EQ(arr_1.keys_begin(), arr_1.keys_end());
+}
+
+TEST_F(ElementArrayTest, Children_HaveNoKeys) {
+    Maze::Element obj(Maze::Type::Object);
+    obj.set("key", "value");
+
+    Maze::Element el(Maze::Type::Array);
+    el.push_back(obj.take("key"));
+
+    EXPECT_EQ(el[0].s(), "value");
+    EXPECT_EQ(el[0].get_key(), "");
+}
+
+TEST_F(ElementArrayTest, ExistsAndIndexOf) {
+    EXPECT_TRUE(arr_1.exists("~0"));
+    EXPECT_TRUE(arr_1.exists("~2"));
+    EXPECT_FALSE(arr_1.exists("~3"));
+    EXPECT_FALSE(arr_1.exists("~01"));
+    EXPECT_FALSE(arr_1.exists("~"));
+    EXPECT_FALSE(arr_1.exists("~1a"));
+    EXPECT_FALSE(arr_1.exists("1"));
+    EXPECT_FALSE(arr_1.exists("~99999999999999999999"));
+
+    EXPECT_EQ(arr_1.index_of("~1"), 1);
+    EXPECT_EQ(arr_1.index_of("val1"), -1);
+}
+
 TEST_F(ElementArrayTest, IsString) {
     EXPECT_TRUE(arr_1.is_string(0));
     EXPECT_FALSE(arr_1.is_string(1));
@@ -0,0 +1,196 @@
+#include <gtest/gtest.h>
+#include <Maze/Maze.hpp>
+
+class ElementMoveTest : public ::testing::Test {
+protected:
+    Maze::Element big_arr;
+
+    void SetUp() override {
+        big_arr = Maze::Element(Maze::Type::Array);
+        for (int i = 0; i < 1000; ++i) {
+            big_arr << i;
+        }
+    }
+};
+
+TEST_F(ElementMoveTest, MoveConstruct_StealsChildren) {
+    const Maze::Element* first_child = &big_arr.get_children()[0];
+
+    Maze::Element moved(std::move(big_arr));
+
+    EXPECT_TRUE(moved.is_array());
+    EXPECT_EQ(moved.count_children(), 1000);
+    EXPECT_EQ(&moved.get_children()[0], first_child);
+    EXPECT_TRUE(big_arr.is_null());
+}
+
+TEST_F(ElementMoveTest, MoveAssign_StealsChildren) {
+    const Maze::Element* first_child = &big_arr.get_children()[0];
+
+    Maze::Element el("previous value");
+    el = std::move(big_arr);
+
+    EXPECT_TRUE(el.is_array());
+    EXPECT_EQ(&el.get_children()[0], first_child);
+    EXPECT_TRUE(big_arr.is_null());
+}
+
+TEST_F(ElementMoveTest, MoveAssign_KeepsKey) {
+    Maze::Element obj(Maze::Type::Object);
+    obj.set("key", 1);
+
+    obj["key"] = Maze::Element("moved");
+
+    EXPECT_EQ(obj["key"].s(), "moved");
+    EXPECT_EQ(obj[0].get_key(), "key");
+}
+
+TEST_F(ElementMoveTest, MoveConstruct_FromObjectChildKeepsKeyInObject) {
+    Maze::Element obj(Maze::Type::Object);
+    obj.set("alpha", 1);
+    obj.set("beta", 2);
+
+    Maze::Element moved = std::move(obj["alpha"]);
+
+    EXPECT_EQ(moved.i(), 1);
+    EXPECT_EQ(moved.get_key(), "");
+    EXPECT_EQ(obj[0].get_key(), "alpha");
+    EXPECT_EQ(obj.get_keys(), std::vector<std::string>({ "alpha", "beta" }));
+    EXPECT_EQ(obj.to_json(-1), "{\"alpha\":null,\"beta\":2}");
+
+    Maze::Element applied(Maze::Type::Object);
+    applied.set("alpha", 5);
+    applied.apply(obj);
+    EXPECT_EQ(applied.to_json(-1), "{\"alpha\":null,\"beta\":2}");
+
+    // Taking a child hands over its key as well
+    Maze::Element taken = obj.take("beta");
+    EXPECT_EQ(taken.i(), 2);
+    EXPECT_EQ(taken.get_key(), "beta");
+}
+
+TEST_F(ElementMoveTest, MoveAssign_FromOwnChild) {
+    Maze::Element obj(Maze::Type::Object);
+    obj.set("inner", std::move(big_arr));
+
+    obj = std::move(obj["inner"]);
+
+    EXPECT_TRUE(obj.is_array());
+    EXPECT_EQ(obj.count_children(), 1000);
+    EXPECT_EQ(obj[999].i(), 999);
+}
+
+TEST_F(ElementMoveTest, MoveString) {
+    std::pmr::string value(100, 'x');
+    const char* data = value.data();
+
+    Maze::Element el(std::move(value));
+    EXPECT_EQ(el.s().data(), data);
+
+    std::pmr::string other(100, 'y');
+    data = other.data();
+    el = std::move(other);
+    EXPECT_EQ(el.s().data(), data);
+}
+
+TEST_F(ElementMoveTest, SetArray_Rvalue) {
+    const Maze::Element* first_child = &big_arr.get_children()[0];
+    std::vector<Maze::Element> values;
+    values.push_back(1);
+    values.push_back(std::move(big_arr));
+    values.push_back(3);
+
+    Maze::Element el(std::move(values));
+
+    EXPECT_EQ(el.count_children(), 3);
+    EXPECT_EQ(&el[1].get_children()[0], first_child);
+    EXPECT_EQ(el.get_keys(), std::vector<std::string>({ "~0", "~1", "~2" }));
+}
+
+TEST_F(ElementMoveTest, SetObject_Rvalue) {
+    const Maze::Element* first_child = &big_arr.get_children()[0];
+    std::vector<std::string> keys = { "a", "b" };
+    std::vector<Maze::Element> values;
+    values.push_back("x");
+    values.push_back(std::move(big_arr));
+
+    Maze::Element el(std::move(keys), std::move(values));
+
+    EXPECT_EQ(&el[1].get_children()[0], first_child);
+    EXPECT_EQ(el["b"].count_children(), 1000);
+    EXPECT_EQ(el[1].get_key(), "b");
+}
+
+TEST_F(ElementMoveTest, PushBack_Rvalue) {
+    const Maze::Element* first_child = &big_arr.get_children()[0];
+
+    Maze::Element el(Maze::Type::Array);
+    el.push_back(std::move(big_arr));
+
+    EXPECT_EQ(&el[0].get_children()[0], first_child);
+    EXPECT_EQ(el[0].get_key(), "");
+}
+
+TEST_F(ElementMoveTest, Set_Rvalue) {
+    const Maze::Element* first_child = &big_arr.get_children()[0];
+
+    Maze::Element el(Maze::Type::Object);
+    el.set("arr", std::move(big_arr));
+
+    EXPECT_EQ(&el["arr"].get_children()[0], first_child);
+}
+
+TEST_F(ElementMoveTest, EmplaceBack) {
+    Maze::Element el(Maze::Type::Array);
+
+    Maze::Element& child = el.emplace_back(Maze::Type::Object);
+    child.set("key", "value");
+
+    EXPECT_EQ(el.count_children(), 1);
+    EXPECT_EQ(el[0]["key"].s(), "value");
+    EXPECT_EQ(el.emplace_back("str").s(), "str");
+    EXPECT_EQ(el[1].get_key(), "");
+}
+
+TEST_F(ElementMoveTest, Emplace) {
+    Maze::Element el(Maze::Type::Object);
+
+    Maze::Element& child = el.emplace("list", Maze::Type::Array);
+    child << 1 << 2;
+    el.emplace("name", "maze");
+
+    EXPECT_EQ(el["list"].count_children(), 2);
+    EXPECT_EQ(el["name"].s(), "maze");
+
+    el.emplace("name", 42);
+    EXPECT_EQ(el.count_children(), 2);
+    EXPECT_EQ(el["name"].i(), 42);
+}
+
+TEST_F(ElementMoveTest, TakeIndex) {
+    Maze::Element el(Maze::Type::Array);
+    el << "first" << std::move(big_arr) << "last";
+
+    Maze::Element taken = el.take(1);
+
+    EXPECT_EQ(taken.count_children(), 1000);
+    EXPECT_EQ(el.count_children(), 2);
+    EXPECT_EQ(el[1].s(), "last");
+    EXPECT_THROW(el.take(5), Maze::MazeException);
+}
+
+TEST_F(ElementMoveTest, TakeKey) {
+    Maze::Element el(Maze::Type::Object);
+    el.set("a", 1);
+    el.set("b", std::move(big_arr));
+    el.set("c", 3);
+
+    Maze::Element taken = el.take("b");
+
+    EXPECT_EQ(taken.count_children(), 1000);
+    EXPECT_EQ(el.count_children(), 2);
+    EXPECT_FALSE(el.exists("b"));
+    EXPECT_EQ(el["c"].i(), 3);
+    EXPECT_EQ(el[1].get_key(), "c");
+    EXPECT_TRUE(el.take("missing").is_null());
+}
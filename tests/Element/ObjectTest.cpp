@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include <Maze/Maze.hpp>
+#include <thread>
 
 class ElementObjectTest : public ::testing::Test {
 protected:
@@ -118,6 +119,59 @@ TEST_F(ElementObjectTest, SetElement_ToNull) {
     EXPECT_TRUE(el.get("val1").is_null());
 }
 
+TEST_F(ElementObjectTest, SetMany) {
+    Maze::Element el(Maze::Type::Object);
+    el.set_many({ "key1", "key2", "key3" }, { "val1", 42, true });
+
+    EXPECT_EQ(el.count_children(), 3);
+    EXPECT_EQ(el.get_keys(), std::vector<std::string>({ "key1", "key2", "key3" }));
+    EXPECT_EQ(el["key2"].i(), 42);
+    EXPECT_EQ(el[2].get_key(), "key3");
+}
+
+TEST_F(ElementObjectTest, SetMany_ReplacesExisting) {
+    obj_1.set_many({ "val4", "val2", "val4" }, { "new", 99, "newer" });
+
+    EXPECT_EQ(obj_1.get_keys(), std::vector<std::string>({ "val1", "val2", "val3", "val4" }));
+    EXPECT_EQ(obj_1["val2"].i(), 99);
+    EXPECT_EQ(obj_1["val4"].s(), "newer");
+    EXPECT_EQ(obj_1[3].get_key(), "val4");
+}
+
+TEST_F(ElementObjectTest, SetMany_Wide) {
+    std::vector<std::string> keys;
+    std::vector<Maze::Element> values;
+    for (int i = 0; i < 1000; ++i) {
+        keys.push_back("key" + std::to_string(i % 600));
+        values.push_back(i);
+    }
+
+    Maze::Element el(Maze::Type::Object);
+    el.set_many(std::move(keys), std::move(values));
+
+    EXPECT_EQ(el.count_children(), 600);
+    EXPECT_EQ(el[0].get_key(), "key0");
+    EXPECT_EQ(el["key0"].i(), 600);
+    EXPECT_EQ(el["key599"].i(), 599);
+    EXPECT_EQ(el[599].get_key(), "key599");
+}
+
+TEST_F(ElementObjectTest, SetMany_UniqueKeys) {
+    Maze::Element el(Maze::Type::Object);
+    el.set_many({ "key1", "key2" }, { "val1", 42 }, true);
+
+    EXPECT_EQ(el.count_children(), 2);
+    EXPECT_EQ(el["key1"].s(), "val1");
+}
+
+TEST_F(ElementObjectTest, SetMany_Invalid_Throws) {
+    Maze::Element el(Maze::Type::Object);
+    EXPECT_THROW(el.set_many({ "key1", "key2" }, { "val1" }), Maze::MazeException);
+
+    Maze::Element arr(Maze::Type::Array);
+    EXPECT_THROW(arr.set_many({ "key1" }, { "val1" }), Maze::MazeException);
+}
+
 TEST_F(ElementObjectTest, Remove) {
     EXPECT_EQ(obj_1.count_children(), 3);
 
@@ -160,6 +214,244 @@ TEST_F(ElementObjectTest, GetKeys) {
     EXPECT_EQ(obj_1.get_keys(), std::vector<std::string>({ "val1", "val2", "val3" }));
 }
 
+TEST_F(ElementObjectTest, Wide_Lookup) {
+    Maze::Element el(Maze::Type::Object);
+    for (int i = 0; i < 10000; ++i) {
+        el.set("user_" + std::to_string(i), i);
+    }
+
+    EXPECT_EQ(el.count_children(), 10000);
+    for (int i = 0; i < 10000; i += 7) {
+        EXPECT_EQ(el.index_of("user_" + std::to_string(i)), i);
+    }
+    EXPECT_EQ(el["user_9999"].i(), 9999);
+    EXPECT_FALSE(el.exists("user_10000"));
+    EXPECT_EQ(el.get_keys()[42], "user_42");
+}
+
+TEST_F(ElementObjectTest, Wide_Remove) {
+    Maze::Element el(Maze::Type::Object);
+    for (int i = 0; i < 100; ++i) {
+        el.set("key" + std::to_string(i), i);
+    }
+    EXPECT_EQ(el.index_of("key50"), 50);
+
+    el.remove("key10");
+    EXPECT_FALSE(el.exists("key10"));
+    EXPECT_EQ(el.index_of("key50"), 49);
+
+    el.remove_at(0);
+    EXPECT_FALSE(el.exists("key0"));
+    EXPECT_EQ(el.index_of("key50"), 48);
+
+    el.set("key10", 10);
+    EXPECT_EQ(el.index_of("key10"), 98);
+    EXPECT_EQ(el.get_keys().back(), "key10");
+
+    el.remove_all_children();
+    EXPECT_FALSE(el.exists("key50"));
+}
+
+TEST_F(ElementObjectTest, Wide_RenameKey) {
+    Maze::Element el(Maze::Type::Object);
+    for (int i = 0; i < 100; ++i) {
+        el.set("key" + std::to_string(i), i);
+    }
+    EXPECT_TRUE(el.exists("key5"));
+
+    el.rename_key(5, "renamed");
+    EXPECT_FALSE(el.exists("key5"));
+    EXPECT_EQ(el.index_of("renamed"), 5);
+    EXPECT_EQ(el[5].get_key(), "renamed");
+    EXPECT_EQ(el.get_keys()[5], "renamed");
+
+    el.rename_key("renamed", "key5");
+    EXPECT_EQ(el.index_of("key5"), 5);
+    EXPECT_EQ(el["key5"].i(), 5);
+
+    EXPECT_THROW(el.rename_key(6, "key7"), Maze::MazeException);
+    EXPECT_THROW(el.rename_key(100, "key100"), Maze::MazeException);
+    EXPECT_EQ(el.index_of("key6"), 6);
+
+    // Copies made before renaming keep the old key
+    Maze::Element copy = el;
+    el.rename_key("key6", "six");
+    EXPECT_TRUE(el.exists("six"));
+    EXPECT_TRUE(copy.exists("key6"));
+    EXPECT_FALSE(copy.exists("six"));
+}
+
+TEST_F(ElementObjectTest, Keys_SharedBetweenObjects) {
+    Maze::Element first = Maze::Element::from_json(R"({ "id": 1, "name": "first" })");
+    Maze::Element second(Maze::Type::Object);
+    second.set("name", "second");
+
+    EXPECT_EQ(&first[1].get_key(), &second[0].get_key());
+    EXPECT_EQ(second[0].get_key(), "name");
+    EXPECT_FALSE(second.exists("a key that was never used anywhere"));
+}
+
+TEST_F(ElementObjectTest, Remove_RenumbersChildKeys) {
+    Maze::Element el(Maze::Type::Object);
+    el << "a" << "b" << "c";
+
+    el.remove("~0");
+
+    EXPECT_EQ(el.get_keys(), std::vector<std::string>({ "~0", "~1" }));
+    EXPECT_EQ(el[0].get_key(), "~0");
+    EXPECT_EQ(el["~1"].s(), "c");
+}
+
+TEST_F(ElementObjectTest, Lookup_StringView) {
+    Maze::Element el(Maze::Type::Object);
+    el.set("upstream_connection_timeout", 30);
+
+    const std::string buffer = "upstream_connection_timeout_ms";
+    const std::string_view key(buffer.data(), 27);
+
+    EXPECT_TRUE(el.exists(key));
+    EXPECT_TRUE(el.is_int(key));
+    EXPECT_EQ(el[key].i(), 30);
+    EXPECT_EQ(el.index_of(std::string_view(buffer)), -1);
+
+    el[key] = 60;
+    el.set(std::string_view(buffer.data(), 8), "upstream");
+
+    EXPECT_EQ(el["upstream_connection_timeout"].i(), 60);
+    EXPECT_EQ(el["upstream"].s(), "upstream");
+    EXPECT_EQ(el.take(key).i(), 60);
+    EXPECT_FALSE(el.exists(key));
+}
+
+TEST_F(ElementObjectTest, Keys_ConcurrentInterning) {
+    std::vector<std::thread> workers;
+    std::vector<Maze::Element> results(4, Maze::Element(Maze::Type::Object));
+
+    for (int t = 0; t < 4; ++t) {
+        workers.emplace_back([&results, t]() {
+            Maze::Element& el = results[t];
+
+            for (int i = 0; i < 3000; ++i) {
+                // Half of the keys are shared between threads, half are new
+                el.set(i % 2 == 0 ? "interned_" + std::to_string(i) : "interned_" + std::to_string(t) + "_" + std::to_string(i), i);
+            }
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+
+    for (int t = 0; t < 4; ++t) {
+        EXPECT_EQ(results[t].count_children(), 3000);
+        EXPECT_EQ(results[t]["interned_1500"].i(), 1500);
+        EXPECT_EQ(results[t]["interned_" + std::to_string(t) + "_2999"].i(), 2999);
+        EXPECT_EQ(&results[t]["interned_42"].get_key(), &results[0]["interned_42"].get_key());
+    }
+}
+
+TEST_F(ElementObjectTest, Keys_LongKeysAreCounted) {
+    // Keys this long never enter the permanent part of the key table
+    const std::string long_key(300, 'k');
+    const std::string other_key = long_key + "_other";
+
+    Maze::Element copy;
+    {
+        Maze::Element el = Maze::Element::from_json("{\"" + long_key + "\": 1}");
+        el.set(other_key, 2);
+        copy = el;
+
+        EXPECT_EQ(&el[0].get_key(), &copy[0].get_key());
+        el.remove(long_key);
+        EXPECT_FALSE(el.exists(long_key));
+    }
+
+    EXPECT_EQ(copy[0].get_key(), long_key);
+    EXPECT_EQ(copy[long_key].i(), 1);
+    EXPECT_EQ(copy.take(long_key).i(), 1);
+    EXPECT_EQ(copy.get_keys(), std::vector<std::string>({ other_key }));
+
+    copy.remove_all_children();
+    EXPECT_FALSE(copy.exists(other_key));
+
+    // Keys released by one object can be interned again by another
+    std::vector<std::thread> workers;
+    std::vector<int> found(4, 0);
+    for (int t = 0; t < 4; ++t) {
+        workers.emplace_back([&found, &long_key, t]() {
+            for (int i = 0; i < 200; ++i) {
+                Maze::Element el(Maze::Type::Object);
+                el.set(long_key + std::to_string(i % 10), i);
+
+                if (el.get(long_key + std::to_string(i % 10)).get_int() == i)
+                    ++found[t];
+            }
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+
+    EXPECT_EQ(found, std::vector<int>(4, 200));
+
+    Maze::Element again(Maze::Type::Object);
+    again.set(long_key, 3);
+    EXPECT_EQ(again[long_key].i(), 3);
+    EXPECT_EQ(again[0].get_key(), long_key);
+}
+
+TEST_F(ElementObjectTest, Keys_LongKeyOutlivesMovedChild) {
+    const std::string long_key(300, 'm');
+    const std::string later_key(300, 'n');
+
+    Maze::Element obj(Maze::Type::Object);
+    obj.set(long_key, 1);
+    obj.set("short", 2);
+
+    {
+        Maze::Element moved = std::move(obj[long_key]);
+        EXPECT_EQ(moved.i(), 1);
+    }
+
+    // The object still names the child, so its key was not released with the moved value
+    EXPECT_TRUE(obj.exists(long_key));
+    EXPECT_EQ(obj.get_keys(), std::vector<std::string>({ long_key, "short" }));
+    EXPECT_EQ(obj.to_json(-1), "{\"" + long_key + "\":null,\"short\":2}");
+
+    obj.set(later_key, 3);
+    EXPECT_EQ(obj.count_children(), 3);
+    EXPECT_TRUE(obj.exists(long_key));
+    EXPECT_EQ(obj[later_key].i(), 3);
+    EXPECT_EQ(obj.get_keys(), std::vector<std::string>({ long_key, "short", later_key }));
+}
+
+TEST_F(ElementObjectTest, Wide_ConcurrentLookup) {
+    Maze::Element el(Maze::Type::Object);
+    for (int i = 0; i < 5000; ++i) {
+        el.set("key" + std::to_string(i), i);
+    }
+    el.remove("key0");
+
+    const Maze::Element& shared = el;
+    std::vector<std::thread> threads;
+    std::vector<int> found(8, 0);
+
+    for (int t = 0; t < 8; ++t) {
+        threads.emplace_back([&shared, &found, t]() {
+            for (int i = 1; i < 5000; ++i) {
+                if (shared.get("key" + std::to_string(i)).get_int() == i)
+                    ++found[t];
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (int t = 0; t < 8; ++t) {
+        EXPECT_EQ(found[t], 4999);
+    }
+}
+
 TEST_F(ElementObjectTest, IsString) {
     EXPECT_TRUE(obj_1.is_string("val1"));
     EXPECT_FALSE(obj_1.is_string("val2"));
@@ -241,6 +533,20 @@ TEST_F(ElementObjectTest, FromJsonString) {
     EXPECT_TRUE(parsed["config"].is_object());
 }
 
+TEST_F(ElementObjectTest, FromJsonString_WideDuplicateKeys) {
+    std::string input = "{";
+    for (int i = 0; i < 100; ++i) {
+        input += "\"key" + std::to_string(i % 40) + "\": " + std::to_string(i) + (i < 99 ? "," : "}");
+    }
+
+    Maze::Element parsed = Maze::Element::from_json(input);
+
+    EXPECT_EQ(parsed.count_children(), 40);
+    EXPECT_EQ(parsed[0].get_key(), "key0");
+    EXPECT_EQ(parsed["key0"].i(), 80);
+    EXPECT_EQ(parsed["key39"].i(), 79);
+}
+
 TEST_F(ElementObjectTest, ToJsonString) {
     Maze::Element el({ "key1", "key2" }, { "val1", 42 });
 
@@ -0,0 +1,173 @@
+#include <gtest/gtest.h>
+#include <Maze/Maze.hpp>
+#include <thread>
+
+class ElementStorageTest : public ::testing::Test {};
+
+TEST_F(ElementStorageTest, Size_FitsInTwoCacheLines) {
+    EXPECT_LE(sizeof(Maze::Element), 128);
+}
+
+TEST_F(ElementStorageTest, ChangeType_ReleasesPreviousValue) {
+    Maze::Element el("a string that is long enough to skip small string optimization");
+    ASSERT_TRUE(el.is_string());
+
+    el.set_int(42);
+    ASSERT_TRUE(el.is_int());
+    ASSERT_EQ(el.get_int(), 42);
+    ASSERT_EQ(el.get_string(), "");
+
+    el.set_type(Maze::Type::Object);
+    el.set("key", "value");
+    ASSERT_TRUE(el.is_object());
+
+    el.set_double(9.9);
+    ASSERT_TRUE(el.is_double());
+    ASSERT_EQ(el.count_children(), 0);
+    ASSERT_TRUE(el.get_children().empty());
+    ASSERT_TRUE(el.get_keys().empty());
+}
+
+TEST_F(ElementStorageTest, Assign_Itself) {
+    Maze::Element el(Maze::Type::Array);
+    el << "val1" << 42;
+
+    el = el;
+    ASSERT_TRUE(el.is_array());
+    ASSERT_EQ(el.count_children(), 2);
+}
+
+TEST_F(ElementStorageTest, Assign_OwnChild) {
+    Maze::Element el(Maze::Type::Object);
+    el.set("inner", Maze::Element(std::vector<Maze::Element>{ "val1", 42 }));
+    el.set("str", "value");
+
+    el = el["inner"];
+    ASSERT_TRUE(el.is_array());
+    ASSERT_EQ(el.count_children(), 2);
+    ASSERT_EQ(el[0].s(), "val1");
+
+    Maze::Element obj(Maze::Type::Object);
+    obj.set("str", "value");
+    obj.set_string(obj["str"].s());
+    ASSERT_TRUE(obj.is_string());
+    ASSERT_EQ(obj.s(), "value");
+}
+
+TEST_F(ElementStorageTest, Copy_IsIndependent) {
+    Maze::Element el(Maze::Type::Object);
+    el.set("key", "value");
+
+    Maze::Element copy = el;
+    copy["key"] = "changed";
+
+    ASSERT_EQ(el["key"].s(), "value");
+    ASSERT_EQ(copy["key"].s(), "changed");
+}
+
+TEST_F(ElementStorageTest, Iterate_NonContainer) {
+    Maze::Element el(42);
+
+    int count = 0;
+    for ([[maybe_unused]] auto& child : el) {
+        ++count;
+    }
+
+    ASSERT_EQ(count, 0);
+}
+
+TEST_F(ElementStorageTest, Copy_SharesChildren) {
+    Maze::Element el = Maze::Element::from_json(R"({ "config": { "list": [1, 2, 3] }, "name": "maze" })");
+    const Maze::Element& original = el;
+
+    const Maze::Element copy = el;
+    const Maze::Element fallback = original.get("config", Maze::Element());
+
+    EXPECT_EQ(&copy.get_children()[0], &original.get_children()[0]);
+    EXPECT_EQ(&fallback.get_children()[0], &original["config"].get_children()[0]);
+}
+
+TEST_F(ElementStorageTest, Copy_ModifyClonesOnlyModifiedPath) {
+    Maze::Element el = Maze::Element::from_json(R"({ "a": { "list": [1, 2, 3] }, "b": { "list": [4, 5, 6] } })");
+    const Maze::Element& original = el;
+
+    Maze::Element copy = el;
+    copy["a"]["list"] << 4;
+
+    EXPECT_EQ(original["a"]["list"].count_children(), 3);
+    EXPECT_EQ(copy["a"]["list"].count_children(), 4);
+
+    const Maze::Element& const_copy = copy;
+    EXPECT_NE(&const_copy["a"]["list"].get_children()[0], &original["a"]["list"].get_children()[0]);
+    EXPECT_EQ(&const_copy["b"]["list"].get_children()[0], &original["b"]["list"].get_children()[0]);
+
+    el.remove("b");
+    EXPECT_FALSE(el.exists("b"));
+    EXPECT_EQ(copy["b"]["list"][2].i(), 6);
+}
+
+TEST_F(ElementStorageTest, Copy_ReferencesTakenBeforeCopy) {
+    Maze::Element root = Maze::Element::from_json(R"({ "cfg": { "timeout": 30 }, "users": [] })");
+
+    Maze::Element& users = root["users"];
+    Maze::Element& cfg = root["cfg"];
+    Maze::Element snap = root;
+
+    users.push_back(42);
+    cfg["timeout"] = 99;
+
+    EXPECT_EQ(root.to_json(-1), R"({"cfg":{"timeout":99},"users":[42]})");
+    EXPECT_EQ(snap.to_json(-1), R"({"cfg":{"timeout":30},"users":[]})");
+}
+
+TEST_F(ElementStorageTest, Copy_NestedReferencesTakenBeforeCopy) {
+    Maze::Element root = Maze::Element::from_json(R"({ "a": { "b": { "c": 1 } }, "list": [1, 2, 3] })");
+
+    Maze::Element& c = root["a"]["b"]["c"];
+    Maze::Element& first = root["list"][0];
+    Maze::Element snap = root;
+    Maze::Element snap_of_a = root["a"];
+
+    c = 2;
+    first = "changed";
+    for (Maze::Element& child : root["list"]) {
+        if (child.is_int())
+            child = child.i() * 10;
+    }
+
+    EXPECT_EQ(root.to_json(-1), R"({"a":{"b":{"c":2}},"list":["changed",20,30]})");
+    EXPECT_EQ(snap.to_json(-1), R"({"a":{"b":{"c":1}},"list":[1,2,3]})");
+    EXPECT_EQ(snap_of_a.to_json(-1), R"({"b":{"c":1}})");
+
+    // Copies of the copies share what nobody borrowed
+    const Maze::Element second = snap;
+    EXPECT_EQ(&second.get_children()[0], &static_cast<const Maze::Element&>(snap).get_children()[0]);
+}
+
+TEST_F(ElementStorageTest, Copy_ConcurrentModify) {
+    Maze::Element config(Maze::Type::Object);
+    for (int i = 0; i < 100; ++i) {
+        config.set("key" + std::to_string(i), Maze::Element({ i, "value" }));
+    }
+    const Maze::Element& shared = config;
+
+    std::vector<std::thread> workers;
+    std::vector<int> results(4, 0);
+    for (int t = 0; t < 4; ++t) {
+        workers.emplace_back([&shared, &results, t]() {
+            for (int i = 0; i < 100; ++i) {
+                Maze::Element copy = shared;
+                copy["key" + std::to_string(i)][0] = t;
+                results[t] += copy["key" + std::to_string(i)][0].i() + shared["key" + std::to_string(i)][0].i();
+            }
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+
+    for (int t = 0; t < 4; ++t) {
+        EXPECT_EQ(results[t], t * 100 + 4950);
+    }
+    EXPECT_EQ(shared["key99"][0].i(), 99);
+}
@@ -71,6 +71,18 @@ TEST(HelpersTest, Element_ToJsonElement_Object) {
 	ASSERT_TRUE(result.is_object());
 }
 
+TEST(HelpersTest, Element_ToJsonElement_ObjectAfterChildMovedOut) {
+	Element el(Maze::Type::Object);
+	el.set("alpha", 1);
+	el.set("beta", 2);
+
+	Element moved = std::move(el["alpha"]);
+
+	auto result = Maze::Helpers::Element::to_json_element(el);
+
+	ASSERT_EQ(result.dump(), "{\"alpha\":null,\"beta\":2}");
+}
+
 TEST(HelpersTest, Element_ElementFromJson_Null) {
 	nlohmann::json json_el;
 
@@ -95,6 +107,15 @@ TEST(HelpersTest, Element_ElementFromJson_Int) {
 	ASSERT_TRUE(result.is_int());
 }
 
+TEST(HelpersTest, Element_ElementFromJson_WideInt) {
+	auto result = Maze::Helpers::Element::from_json(nlohmann::json::parse("[4294967296, -2147483649, 18446744073709551615]"));
+
+	ASSERT_TRUE(result[0].is_double());
+	EXPECT_EQ(result[0].d(), 4294967296.0);
+	EXPECT_EQ(result[1].d(), -2147483649.0);
+	EXPECT_EQ(result[2].d(), 18446744073709551615.0);
+}
+
 TEST(HelpersTest, Element_ElementFromJson_Double) {
 	nlohmann::json json_el = 9876.54321;
 
@@ -0,0 +1,345 @@
+#include <gtest/gtest.h>
+#include <Maze/Maze.hpp>
+#include <climits>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+using Maze::Element;
+
+class JsonParserTest : public ::testing::Test {};
+
+TEST_F(JsonParserTest, Parse_NestedDocument) {
+	Element el = Element::from_json(R"({
+		"name": "maze",
+		"version": [1, 2, 0],
+		"ratio": -0.5e2,
+		"enabled": true,
+		"nothing": null,
+		"nested": { "list": [ {}, [], "" ] }
+	})");
+
+	ASSERT_TRUE(el.is_object());
+	EXPECT_EQ(el.count_children(), 6);
+	EXPECT_EQ(el["name"].s(), "maze");
+	EXPECT_EQ(el["version"].count_children(), 3);
+	EXPECT_EQ(el["version"][2].i(), 0);
+	EXPECT_EQ(el["ratio"].d(), -50.0);
+	EXPECT_TRUE(el["enabled"].b());
+	EXPECT_TRUE(el["nothing"].is_null());
+	EXPECT_TRUE(el["nested"]["list"][0].is_object());
+	EXPECT_TRUE(el["nested"]["list"][1].is_array());
+	EXPECT_TRUE(el["nested"]["list"][2].is_string());
+}
+
+TEST_F(JsonParserTest, Parse_KeepsKeyOrder) {
+	Element el = Element::from_json(R"({"b": 1, "a": 2, "c": 3})");
+
+	EXPECT_EQ(el.get_keys(), std::vector<std::string>({ "b", "a", "c" }));
+	EXPECT_EQ(el[1].get_key(), "a");
+}
+
+TEST_F(JsonParserTest, Parse_DuplicateKeys_LastWins) {
+	Element el = Element::from_json(R"({"a": 1, "b": 2, "a": "three"})");
+
+	EXPECT_EQ(el.count_children(), 2);
+	EXPECT_EQ(el["a"].s(), "three");
+}
+
+TEST_F(JsonParserTest, Parse_ArrayKeys) {
+	Element el = Element::from_json("[1, 2, 3]");
+
+	EXPECT_EQ(el.get_keys(), std::vector<std::string>({ "~0", "~1", "~2" }));
+	EXPECT_EQ(el[2].get_key(), "");
+}
+
+TEST_F(JsonParserTest, Parse_StringEscapes) {
+	Element el = Element::from_json(R"("quote\" slash\\ \/ \b\f\n\r\t \u0041\u00e9\u20ac\ud83d\ude00")");
+
+	EXPECT_EQ(el.s(), "quote\" slash\\ / \b\f\n\r\t A\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80");
+}
+
+TEST_F(JsonParserTest, Parse_Utf8PassesThrough) {
+	Element el = Element::from_json("\"\xC5\xA1\xC4\x8D\xC5\xBE\"");
+
+	EXPECT_EQ(el.s(), "\xC5\xA1\xC4\x8D\xC5\xBE");
+}
+
+TEST_F(JsonParserTest, Parse_Numbers) {
+	EXPECT_TRUE(Element::from_json("0").is_int());
+	EXPECT_EQ(Element::from_json("-42").i(), -42);
+	EXPECT_EQ(Element::from_json("2147483647").i(), 2147483647);
+	EXPECT_TRUE(Element::from_json("2147483648").is_double());
+	EXPECT_EQ(Element::from_json("2147483648").d(), 2147483648.0);
+	EXPECT_TRUE(Element::from_json("1.0").is_double());
+	EXPECT_EQ(Element::from_json("1E3").d(), 1000.0);
+	EXPECT_EQ(Element::from_json("-2147483648").i(), INT_MIN);
+	EXPECT_TRUE(Element::from_json("-2147483649").is_double());
+	EXPECT_EQ(Element::from_json("0.30000000000000004").d(), 0.30000000000000004);
+	EXPECT_EQ(Element::from_json("[-0, 5e-324]")[1].d(), 5e-324);
+}
+
+TEST_F(JsonParserTest, Parse_Numbers_OutOfRange) {
+	EXPECT_TRUE(std::isinf(Element::from_json("1e400").d()));
+	EXPECT_TRUE(std::isinf(Element::from_json("-1e400").d()));
+	EXPECT_EQ(Element::from_json("1e-400").d(), 0.0);
+	EXPECT_EQ(Element::from_json("123456789012345678901234567890").d(), 123456789012345678901234567890.0);
+}
+
+TEST_F(JsonParserTest, Parse_Whitespace) {
+	Element el = Element::from_json(" \t\r\n[ 1 ,\n2 ] \n");
+
+	EXPECT_EQ(el.count_children(), 2);
+}
+
+TEST_F(JsonParserTest, Parse_Invalid_Throws) {
+	const std::vector<std::string> inputs = {
+		"", " ", "[", "]", "{", "{\"a\"}", "{\"a\":}", "{a: 1}", "[1,]", "[1 2]",
+		"01", "-", "1.", "1e", ".5", "+1", "tru", "nul", "falsey",
+		"\"unterminated", "\"bad \\x escape\"", "\"\\u12\"", "\"\\ud800\"", "\"\\udc00\"",
+		"\"raw \n newline\"", "\"\xC3\"", "\"\xC0\xAF\"", "\"\xED\xA0\x80\"", "\"\xFF\"",
+		"1 2", "{} []"
+	};
+
+	for (const auto& input : inputs) {
+		EXPECT_THROW(Element::from_json(input), Maze::MazeException) << input;
+	}
+}
+
+TEST_F(JsonParserTest, Parse_LongStrings) {
+	const std::pair<std::string, std::string> special[] = {
+		{ "\\\"", "\"" }, { "\\n", "\n" }, { "\\u00e9", "\xC3\xA9" }, { "\xC3\xA9", "\xC3\xA9" }, { "\xF0\x9F\x98\x80", "\xF0\x9F\x98\x80" }
+	};
+
+	// Every special character at every offset of the 16 and 32 byte blocks
+	for (const auto& [encoded, decoded] : special) {
+		for (size_t offset = 0; offset < 70; ++offset) {
+			const std::string input = "\"" + std::string(offset, 'a') + encoded + std::string(40, 'b') + "\"";
+
+			EXPECT_EQ(Element::from_json(input).s(), std::string(offset, 'a') + decoded + std::string(40, 'b')) << offset;
+		}
+	}
+
+	for (const std::string invalid : { "\n", "\xC3", "\xFF", "\xED\xA0\x80" }) {
+		for (size_t offset = 0; offset < 70; ++offset) {
+			const std::string input = "\"" + std::string(offset, 'a') + invalid + std::string(40, 'b') + "\"";
+
+			EXPECT_THROW(Element::from_json(input), Maze::MazeException) << offset;
+		}
+	}
+}
+
+TEST_F(JsonParserTest, Parse_LongMultiByteStrings) {
+	// Two, three and four byte sequences so block boundaries fall inside each of them
+	const std::string text = "\xD0\x96\xE6\x9D\xB1\xF0\x9F\x9A\x80" "a";
+	std::string value;
+	for (int i = 0; i < 12; ++i)
+		value += text;
+
+	for (size_t length = 0; length <= value.size(); ++length) {
+		// Stop on a character boundary, then close the string or follow it with an escape
+		if (length < value.size() && ((unsigned char)value[length] & 0xC0) == 0x80)
+			continue;
+
+		const std::string prefix = value.substr(0, length);
+		EXPECT_EQ(Element::from_json("\"" + prefix + "\"").s(), prefix) << length;
+		EXPECT_EQ(Element::from_json("\"" + prefix + "\\n" + value + "\"").s(), prefix + "\n" + value) << length;
+	}
+
+	for (const std::string invalid : { "\x80", "\xC3", "\xC0\xAF", "\xE6\x9D", "\xED\xA0\x80", "\xF0\x8F\xBF\xBF", "\xF4\x90\x80\x80", "\xFF" }) {
+		for (size_t offset = 0; offset <= value.size(); ++offset) {
+			// Inside a sequence the inserted bytes break the one they split
+			const std::string input = "\"" + value.substr(0, offset) + invalid + value.substr(offset) + "\"";
+
+			EXPECT_THROW(Element::from_json(input), Maze::MazeException) << offset;
+		}
+	}
+}
+
+TEST_F(JsonParserTest, Parse_DeepNesting_Throws) {
+	const std::string input = std::string(5000, '[') + std::string(5000, ']');
+
+	EXPECT_THROW(Element::from_json(input), Maze::MazeException);
+}
+
+TEST_F(JsonParserTest, ApplyJson_MergesObject) {
+	Element el = Element::from_json(R"({"a": 1, "b": {"c": 2}})");
+
+	el.apply_json(R"({"b": {"d": 3}, "e": 4})");
+
+	EXPECT_EQ(el["a"].i(), 1);
+	EXPECT_EQ(el["b"]["c"].i(), 2);
+	EXPECT_EQ(el["b"]["d"].i(), 3);
+	EXPECT_EQ(el["e"].i(), 4);
+}
+
+TEST_F(JsonParserTest, Parse_StringView) {
+	const std::string buffer = R"({ "a": [1, 2] }{ "b": 3 })";
+
+	Element el = Element::from_json(std::string_view(buffer.data(), 15));
+	EXPECT_EQ(el["a"][1].i(), 2);
+
+	el = Element::from_json(buffer.data() + 15, buffer.size() - 15);
+	EXPECT_EQ(el["b"].i(), 3);
+
+	EXPECT_THROW(Element::from_json(buffer.data(), 10), Maze::MazeException);
+}
+
+TEST_F(JsonParserTest, Parse_File) {
+	const std::string path = ::testing::TempDir() + "maze_parse_file.json";
+	{
+		std::ofstream file(path, std::ios::binary);
+		file << R"({ "name": "maze", "list": [1, 2, 3] })";
+	}
+
+	Element el = Element::from_json_file(path);
+	std::remove(path.c_str());
+
+	EXPECT_EQ(el["name"].s(), "maze");
+	EXPECT_EQ(el["list"].count_children(), 3);
+}
+
+TEST_F(JsonParserTest, Parse_FileErrors) {
+	EXPECT_THROW(Element::from_json_file(::testing::TempDir() + "maze_missing_file.json"), Maze::MazeException);
+
+	const std::string path = ::testing::TempDir() + "maze_empty_file.json";
+	std::ofstream(path, std::ios::binary).close();
+
+	EXPECT_THROW(Element::from_json_file(path), Maze::MazeException);
+	std::remove(path.c_str());
+}
+
+TEST_F(JsonParserTest, ParseLazy_MatchesEager) {
+	const std::string input = R"({"a": [1, {"b": [true, null, "x]}"]}, 2.5], "c": {}, "d": [], "a2": {"e": "\"{"}, "c": {"f": 1}})";
+
+	Element lazy = Element::from_json_lazy(input);
+	Element eager = Element::from_json(input);
+
+	EXPECT_EQ(lazy.to_json(), eager.to_json());
+	EXPECT_EQ(lazy["a"][1]["b"][2].s(), "x]}");
+	EXPECT_EQ(lazy["c"]["f"].i(), 1);
+	EXPECT_EQ(Element::from_json_lazy(" 42 ").i(), 42);
+	EXPECT_EQ(Element::from_json_lazy("[]").count_children(), 0);
+}
+
+TEST_F(JsonParserTest, ParseLazy_LargeDocument) {
+	std::string input = "[";
+	for (int i = 0; i < 20000; ++i) {
+		if (i > 0)
+			input += ",";
+		input += R"({"id": )" + std::to_string(i) + R"(, "path": "a\\b\"[{", "tags": [1, [2], {}]})";
+	}
+	input += "]";
+
+	Element lazy = Element::from_json_lazy(input);
+
+	EXPECT_EQ(lazy.to_json(-1), Element::from_json(input).to_json(-1));
+	EXPECT_EQ(lazy[19999]["id"].i(), 19999);
+	EXPECT_EQ(lazy[12345]["path"].s(), "a\\b\"[{");
+	EXPECT_THROW(Element::from_json_lazy(input.substr(0, input.size() - 1)), Maze::MazeException);
+}
+
+TEST_F(JsonParserTest, ParseLazy_DefersValueErrors) {
+	Element el = Element::from_json_lazy(R"({"ok": 1, "bad": [1, 2, tru]})");
+
+	EXPECT_EQ(el["ok"].i(), 1);
+	EXPECT_TRUE(el["bad"].is_array());
+	EXPECT_THROW(el["bad"].count_children(), Maze::MazeException);
+	EXPECT_THROW(el["bad"][0], Maze::MazeException);
+}
+
+TEST_F(JsonParserTest, ParseLazy_StructuralErrors_Throw) {
+	const char* inputs[] = {
+		"", "{", "[1, 2", "[1, 2}", "{\"a\": 1]", "]", "[\"abc]", "[\"abc\\", "[] []", "{} x"
+	};
+
+	for (const auto& input : inputs) {
+		EXPECT_THROW(Element::from_json_lazy(input), Maze::MazeException) << input;
+	}
+
+	const std::string deep = std::string(5000, '[') + std::string(5000, ']');
+	EXPECT_THROW(Element::from_json_lazy(deep), Maze::MazeException);
+}
+
+TEST_F(JsonParserTest, ParseLazy_CopiesAreIndependent) {
+	Element el = Element::from_json_lazy(R"({"list": [1, [2, 3]], "name": "maze"})");
+	Element copy = el;
+
+	copy["list"][1].push_back(Element(4));
+	copy.set("name", Element("copy"));
+
+	EXPECT_EQ(el.to_json(-1), R"({"list":[1,[2,3]],"name":"maze"})");
+	EXPECT_EQ(copy.to_json(-1), R"({"list":[1,[2,3,4]],"name":"copy"})");
+}
+
+TEST_F(JsonParserTest, ParseLazy_ConcurrentReads) {
+	std::string input = "[";
+	for (int i = 0; i < 100; ++i) {
+		input += (i > 0 ? "," : "") + std::string(R"({"id": )") + std::to_string(i) + R"(, "tags": ["a", "b"]})";
+	}
+	input += "]";
+
+	const Element el = Element::from_json_lazy(input);
+
+	std::vector<std::thread> threads;
+	for (int t = 0; t < 4; ++t) {
+		threads.emplace_back([&el]() {
+			for (int i = 0; i < 100; ++i) {
+				EXPECT_EQ(el[i]["id"].i(), i);
+				EXPECT_EQ(el[i]["tags"].count_children(), 2);
+			}
+		});
+	}
+
+	for (auto& thread : threads) {
+		thread.join();
+	}
+}
+
+TEST_F(JsonParserTest, ParseLazy_File) {
+	const std::string path = ::testing::TempDir() + "maze_parse_lazy_file.json";
+	{
+		std::ofstream file(path, std::ios::binary);
+		file << R"({ "name": "maze", "list": [1, 2, 3] })";
+	}
+
+	Element el = Element::from_json_file_lazy(path);
+	std::remove(path.c_str());
+
+	EXPECT_EQ(el["name"].s(), "maze");
+	EXPECT_EQ(el["list"].count_children(), 3);
+}
+
+TEST_F(JsonParserTest, Parse_DistinctKeys_CountedKeysReleased) {
+	auto make_json = [](int round) {
+		std::string json = "{";
+		for (int i = 0; i < 100000; ++i) {
+			json += (i > 0 ? ",\"round_" : "\"round_") + std::to_string(round) + "_key_" + std::to_string(i) + "\":" + std::to_string(i);
+		}
+		json += "}";
+
+		return json;
+	};
+
+	// The first keys fill the permanent part of the key table
+	Element::from_json(make_json(0));
+	const size_t counted = Element::count_counted_keys();
+
+	for (int round = 1; round < 3; ++round) {
+		Element el = Element::from_json(make_json(round));
+		EXPECT_EQ(el["round_" + std::to_string(round) + "_key_99999"].i(), 99999);
+		EXPECT_EQ(Element::count_counted_keys(), counted + 100000);
+
+		Element copy = el;
+		copy.remove("round_" + std::to_string(round) + "_key_0");
+		EXPECT_EQ(Element::count_counted_keys(), counted + 100000);
+
+		el.set_as_null();
+		EXPECT_EQ(Element::count_counted_keys(), counted + 99999);
+
+		copy.set_as_null();
+		EXPECT_EQ(Element::count_counted_keys(), counted);
+	}
+}
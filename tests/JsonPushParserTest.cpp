@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+#include <Maze/JsonPushParser.hpp>
+
+using Maze::Element;
+using Maze::JsonPushParser;
+
+class JsonPushParserTest : public ::testing::Test {};
+
+static const std::string document = R"( {"name": "ma\"ze \u00e9\ud83d\ude00", "list": [1, -2.5e3, true, false, null, [], {}],)"
+	"\"utf8\": \"\xC5\xA1\xC4\x8D\", \"nested\": {\"a\": [{\"b\": 12345}]}, \"name\": \"last\"} ";
+
+static Element parse_in_chunks(const std::string& input, size_t chunk_size) {
+	JsonPushParser parser;
+
+	for (size_t i = 0; i < input.size(); i += chunk_size) {
+		parser.feed(std::string_view(input).substr(i, chunk_size));
+	}
+
+	return parser.finish();
+}
+
+TEST_F(JsonPushParserTest, AllChunkSizes_MatchParser) {
+	const std::string expected = Element::from_json(document).to_json(-1);
+
+	for (size_t chunk_size = 1; chunk_size <= document.size(); ++chunk_size) {
+		ASSERT_EQ(parse_in_chunks(document, chunk_size).to_json(-1), expected) << chunk_size;
+	}
+}
+
+TEST_F(JsonPushParserTest, EverySplitPoint) {
+	const std::string expected = Element::from_json(document).to_json(-1);
+
+	for (size_t split = 0; split <= document.size(); ++split) {
+		JsonPushParser parser;
+		parser.feed(document.data(), split);
+		parser.feed(document.data() + split, document.size() - split);
+
+		ASSERT_EQ(parser.finish().to_json(-1), expected) << split;
+	}
+}
+
+TEST_F(JsonPushParserTest, Scalars) {
+	EXPECT_EQ(parse_in_chunks("12345", 2).i(), 12345);
+	EXPECT_EQ(parse_in_chunks(" -0.5e-2 ", 3).d(), -0.005);
+	EXPECT_EQ(parse_in_chunks("\"text\"", 1).s(), "text");
+	EXPECT_TRUE(parse_in_chunks("null", 1).is_null());
+	EXPECT_TRUE(parse_in_chunks("[]", 1).is_array());
+}
+
+TEST_F(JsonPushParserTest, IsComplete) {
+	JsonPushParser parser;
+
+	parser.feed("{\"a\": [1, 2");
+	EXPECT_FALSE(parser.is_complete());
+
+	parser.feed("]}");
+	EXPECT_TRUE(parser.is_complete());
+
+	parser.feed(" \n");
+	EXPECT_EQ(parser.finish()["a"][1].i(), 2);
+
+	// Parser is ready for the next document after finish()
+	parser.feed("[3]");
+	EXPECT_EQ(parser.finish()[0].i(), 3);
+}
+
+TEST_F(JsonPushParserTest, Invalid_Throws) {
+	const char* inputs[] = {
+		"", "{", "[1, 2", "[1 2]", "[1,]", "{\"a\" 1}", "{\"a\": 1,}", "[tru]", "[1.]", "\"abc",
+		"\"\\x\"", "\"a\x01\"", "\"\xC5\"", "[] []", "{} x", "[}", "{]", "{1: 2}", "-", "[01]"
+	};
+
+	for (const auto& input : inputs) {
+		EXPECT_THROW(parse_in_chunks(input, 1), Maze::MazeException) << input;
+		EXPECT_THROW(Element::from_json(input), Maze::MazeException) << input;
+	}
+
+	const std::string deep = std::string(5000, '[') + std::string(5000, ']');
+	EXPECT_THROW(parse_in_chunks(deep, 64), Maze::MazeException);
+}
+
+TEST_F(JsonPushParserTest, StaysFailedUntilReset) {
+	JsonPushParser parser;
+
+	EXPECT_THROW(parser.feed("[1, }"), Maze::MazeException);
+	EXPECT_THROW(parser.feed("]"), Maze::MazeException);
+	EXPECT_THROW(parser.finish(), Maze::MazeException);
+
+	parser.reset();
+	parser.feed("[1]");
+	EXPECT_EQ(parser.finish().count_children(), 1);
+}
+
+TEST_F(JsonPushParserTest, ErrorOffset) {
+	JsonPushParser parser;
+	parser.feed("[1, 2, ");
+
+	try {
+		parser.feed("3 4]");
+		FAIL() << "Expected MazeException";
+	}
+	catch (const Maze::MazeException& e) {
+		EXPECT_NE(std::string(e.what()).find("at offset 9"), std::string::npos) << e.what();
+	}
+}
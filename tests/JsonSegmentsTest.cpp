@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+#include <Maze/JsonSegments.hpp>
+#include <cstdio>
+#include <utility>
+
+using Maze::Element;
+using Maze::JsonSegments;
+
+class JsonSegmentsTest : public ::testing::Test {};
+
+static Element make_document() {
+	Element el = Element::from_json(R"({"id": 7, "tags": ["a", "b"], "empty": {}, "ratio": 0.5})");
+	el.set("body", Element(std::string(5000, 'x')));
+	el.set("escaped", Element(std::string(3000, 'y') + "\"\n" + std::string(2000, 'z')));
+	el["tags"] << Element(std::string(1500, 't') + "\xC3\xA9");
+
+	return el;
+}
+
+TEST_F(JsonSegmentsTest, MatchesToJson) {
+	const Element el = make_document();
+
+	for (int indentation : { -1, 2 }) {
+		for (size_t min_reference_size : { (size_t)1, (size_t)16, JsonSegments::default_min_reference_size, (size_t)100000 }) {
+			JsonSegments segments(el, indentation, min_reference_size);
+
+			EXPECT_EQ(segments.to_string(), el.to_json(indentation)) << min_reference_size;
+			EXPECT_EQ(segments.size(), el.to_json(indentation).size());
+		}
+	}
+}
+
+TEST_F(JsonSegmentsTest, LargeStrings_ReferencedInPlace) {
+	const Element el = make_document();
+	const std::string_view body = el["body"].get_string();
+	const std::string_view escaped = el["escaped"].get_string();
+
+	JsonSegments segments(el, -1);
+
+	int referenced = 0;
+	for (const JsonSegments::Segment& segment : segments.segments()) {
+		if (segment.data == body.data() && segment.size == body.size())
+			++referenced;
+		if (segment.data == escaped.data() && segment.size == 3000)
+			++referenced;
+		if (segment.data == escaped.data() + 3002 && segment.size == 2000)
+			++referenced;
+	}
+
+	EXPECT_EQ(referenced, 3);
+
+	// Only the structure ends up in scratch segments
+	size_t referenced_size = 0;
+	for (const JsonSegments::Segment& segment : segments.segments()) {
+		if (segment.size >= JsonSegments::default_min_reference_size)
+			referenced_size += segment.size;
+	}
+	EXPECT_LT(segments.size() - referenced_size, 200);
+}
+
+TEST_F(JsonSegmentsTest, Move_KeepsSegmentsValid) {
+	const Element el = Element::from_json(R"([1, "short"])");
+
+	JsonSegments segments(el, -1);
+	JsonSegments moved = std::move(segments);
+
+	EXPECT_EQ(moved.to_string(), R"([1,"short"])");
+}
+
+#ifndef _WIN32
+TEST_F(JsonSegmentsTest, WriteFd) {
+	Element el(Maze::Type::Array);
+	for (int i = 0; i < 3000; ++i) {
+		el << make_document();
+	}
+
+	JsonSegments segments(el, 2);
+	ASSERT_GT(segments.segments().size(), 1024);
+
+	std::FILE* file = std::tmpfile();
+	ASSERT_NE(file, nullptr);
+	segments.write_fd(fileno(file));
+
+	std::string output(segments.size() + 1, '\0');
+	std::rewind(file);
+	output.resize(std::fread(&output[0], 1, output.size(), file));
+	std::fclose(file);
+
+	EXPECT_EQ(output, el.to_json(2));
+	EXPECT_THROW(segments.write_fd(-1), Maze::MazeException);
+}
+#endif
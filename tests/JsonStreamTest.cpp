@@ -0,0 +1,151 @@
+#include <gtest/gtest.h>
+#include <Maze/JsonStream.hpp>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+using Maze::Element;
+using Maze::JsonStream;
+
+class JsonStreamTest : public ::testing::Test {};
+
+TEST_F(JsonStreamTest, TopLevelItems) {
+	std::vector<std::string> items;
+	JsonStream stream([&items](Element&& el) { items.push_back(el.to_json(-1)); });
+
+	std::istringstream input(R"( [ {"a": [1, "]"]}, 2, "x,y", null, [], {"b": {}} ] )");
+	stream.parse(input);
+
+	const std::vector<std::string> expected = { R"({"a":[1,"]"]})", "2", R"("x,y")", "null", "[]", R"({"b":{}})" };
+	EXPECT_EQ(items, expected);
+	EXPECT_EQ(stream.count(), 6);
+}
+
+TEST_F(JsonStreamTest, ItemsAtPath) {
+	std::vector<int> ids;
+	JsonStream stream([&ids](Element&& el) { ids.push_back(el["id"].i()); }, { "data", "items" });
+
+	stream.parse(R"({"meta": {"items": [{"id": 0}]}, "data": {"count": 2, "items": [{"id": 1}, {"id": 2}], "items2": [3]}})");
+
+	EXPECT_EQ(ids, std::vector<int>({ 1, 2 }));
+}
+
+TEST_F(JsonStreamTest, NonArrayAtPath) {
+	std::vector<std::string> items;
+	JsonStream stream([&items](Element&& el) { items.push_back(el.to_json(-1)); }, { "config" });
+
+	stream.parse(R"({"config": {"debug": true}})");
+	EXPECT_EQ(items, std::vector<std::string>({ R"({"debug":true})" }));
+
+	stream.parse(R"({"other": [1, 2]})");
+	EXPECT_EQ(stream.count(), 0);
+
+	stream.parse(R"([{"config": 1}])");
+	EXPECT_EQ(stream.count(), 0);
+}
+
+TEST_F(JsonStreamTest, RecordsLargerThanBuffer) {
+	const std::string long_text(JsonStream::buffer_size * 2 + 17, 'a');
+
+	std::string input = "[";
+	for (int i = 0; i < 5; ++i) {
+		input += (i > 0 ? ", " : "") + std::string(R"({"id": )") + std::to_string(i) + R"(, "text": ")" + long_text + R"(\n"})";
+	}
+	input += "]";
+
+	int count = 0;
+	JsonStream stream([&](Element&& el) {
+		EXPECT_EQ(el["id"].i(), count++);
+		EXPECT_EQ(el["text"].s(), long_text + "\n");
+	});
+
+	std::istringstream stream_input(input);
+	stream.parse(stream_input);
+
+	EXPECT_EQ(count, 5);
+}
+
+TEST_F(JsonStreamTest, Invalid_Throws) {
+	JsonStream stream([](Element&&) {});
+
+	const char* inputs[] = {
+		"", "[", "[1, 2", "[1 2]", "[1,]", "[\"abc", "[{\"a\": tru}]", "[] []", "{\"a\" 1}"
+	};
+
+	for (const auto& input : inputs) {
+		std::istringstream stream_input(input);
+		EXPECT_THROW(stream.parse(stream_input), Maze::MazeException) << input;
+	}
+}
+
+TEST_F(JsonStreamTest, SkippedValuesAreValidated) {
+	JsonStream stream([](Element&&) {}, { "data" });
+
+	const char* inputs[] = {
+		R"({"skip": [1}, "data": [1]})",
+		R"({"skip": {"a": 1]], "data": [1]})",
+		R"({"skip": [[1], "data": [1]})",
+		R"({"skip": tru, "data": [1]})",
+		R"({"skip": 01, "data": [1]})",
+		R"({"skip": 1.e5, "data": [1]})",
+		R"({"skip": -, "data": [1]})",
+		R"({"skip": nulll, "data": [1]})",
+		R"({"skip": abc, "data": [1]})",
+		R"({"skip": [1 2], "data": [1]})",
+		R"({"skip": [1,], "data": [1]})",
+		R"({"skip": {"a" 1}, "data": [1]})",
+		R"({"skip": {1: 2}, "data": [1]})",
+		R"({"skip": {"a": 1,}, "data": [1]})",
+		R"({"skip": "\x", "data": [1]})",
+		R"({"data": [1], "skip": [x]})",
+		R"([1})",
+		R"([1, garbage])",
+		R"({"a": 1)",
+	};
+
+	for (const auto& input : inputs) {
+		std::istringstream stream_input(input);
+		EXPECT_THROW(stream.parse(stream_input), Maze::MazeException) << input;
+	}
+}
+
+TEST_F(JsonStreamTest, SkippedValuesLargerThanBuffer) {
+	std::string skipped = R"({"a": [)";
+	for (size_t i = 0; skipped.size() < JsonStream::buffer_size * 2; ++i) {
+		skipped += (i > 0 ? ", " : "") + std::string(R"({"n": -12.5e3, "s": "\"x\u0041", "t": [true, false, null, {}]})");
+	}
+	skipped += "]}";
+
+	int sum = 0;
+	JsonStream stream([&sum](Element&& el) { sum += el.i(); }, { "data" });
+
+	std::istringstream input(R"({"before": )" + skipped + R"(, "data": [1, 2, 3], "after": )" + skipped + "}");
+	stream.parse(input);
+
+	EXPECT_EQ(sum, 6);
+}
+
+TEST_F(JsonStreamTest, CallbackSeesItemsBeforeError) {
+	int count = 0;
+	JsonStream stream([&count](Element&&) { ++count; });
+
+	EXPECT_THROW(stream.parse("[1, 2, x]"), Maze::MazeException);
+	EXPECT_EQ(count, 2);
+}
+
+TEST_F(JsonStreamTest, ParseFile) {
+	const std::string path = ::testing::TempDir() + "maze_stream_file.json";
+	{
+		std::ofstream file(path, std::ios::binary);
+		file << R"([{"id": 1}, {"id": 2}, {"id": 3}])";
+	}
+
+	int sum = 0;
+	JsonStream stream([&sum](Element&& el) { sum += el["id"].i(); });
+	stream.parse_file(path);
+	std::remove(path.c_str());
+
+	EXPECT_EQ(sum, 6);
+	EXPECT_THROW(stream.parse_file(path), Maze::MazeException);
+}
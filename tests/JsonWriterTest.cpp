@@ -0,0 +1,353 @@
+#include <gtest/gtest.h>
+#include <Maze/Maze.hpp>
+#include <nlohmann/json.hpp>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+
+using Maze::Element;
+
+class JsonWriterTest : public ::testing::Test {};
+
+static const std::string document = R"({
+	"name": "maze",
+	"version": [1, 2, 0],
+	"ratio": 0.25,
+	"enabled": true,
+	"nothing": null,
+	"empty_array": [],
+	"empty_object": {},
+	"nested": { "list": [ {"a": [1, [2, [3]]]}, [], "", -7 ] }
+})";
+
+TEST_F(JsonWriterTest, Pretty_MatchesNlohmann) {
+	Element el = Element::from_json(document);
+	nlohmann::ordered_json json = nlohmann::ordered_json::parse(document);
+
+	EXPECT_EQ(el.to_json(), json.dump(2));
+	EXPECT_EQ(el.to_json(4), json.dump(4));
+	EXPECT_EQ(el.to_json(0), json.dump(0));
+}
+
+TEST_F(JsonWriterTest, Compact_MatchesNlohmann) {
+	Element el = Element::from_json(document);
+	nlohmann::ordered_json json = nlohmann::ordered_json::parse(document);
+
+	EXPECT_EQ(el.to_json(-1), json.dump(-1));
+	EXPECT_EQ(el.to_json(-1), R"({"name":"maze","version":[1,2,0],"ratio":0.25,"enabled":true,"nothing":null,"empty_array":[],"empty_object":{},"nested":{"list":[{"a":[1,[2,[3]]]},[],"",-7]}})");
+}
+
+TEST_F(JsonWriterTest, Doubles_MatchNlohmann) {
+	const std::vector<double> values = {
+		1.0, 0.1, -0.0, 1e-7, 1e100, 1e15, 1e16, 1e21, 5e-324, 0.000123, 1.5e-5, 3.000014,
+		9876.54321, 123456789012345678.0, 123456780000000.0, 2147483648.0, 1.7976931348623157e308,
+		-2.5, 0.30000000000000004, 1.0 / 3.0
+	};
+
+	for (double value : values) {
+		EXPECT_EQ(Element(value).to_json(), nlohmann::json(value).dump());
+	}
+}
+
+TEST_F(JsonWriterTest, Doubles_RoundTrip) {
+	const std::vector<double> values = { 0.1, 1.0 / 3.0, 2.0 / 3.0, 1e-300, 123.456e200, 0.30000000000000004 };
+
+	for (double value : values) {
+		EXPECT_EQ(Element::from_json(Element(value).to_json()).get_double(), value);
+	}
+}
+
+TEST_F(JsonWriterTest, Doubles_Shortest) {
+	EXPECT_EQ(Element(0.3).to_json(), "0.3");
+	EXPECT_EQ(Element(0.1 + 0.2).to_json(), "0.30000000000000004");
+	EXPECT_EQ(Element(46.0512).to_json(), "46.0512");
+	EXPECT_EQ(Element(-1.25e-10).to_json(), "-1.25e-10");
+	EXPECT_EQ(Element(1.7976931348623157e308).to_json(), "1.7976931348623157e+308");
+	EXPECT_EQ(Element(123456789012345.0).to_json(), "123456789012345.0");
+}
+
+TEST_F(JsonWriterTest, Doubles_RoundTrip_Random) {
+	uint64_t state = 88172645463325252ull;
+
+	for (int i = 0; i < 100000; ++i) {
+		state ^= state << 13;
+		state ^= state >> 7;
+		state ^= state << 17;
+
+		double value;
+		std::memcpy(&value, &state, sizeof(value));
+		if (!std::isfinite(value))
+			continue;
+
+		ASSERT_EQ(Element::from_json(Element(value).to_json()).get_double(), value) << Element(value).to_json();
+	}
+}
+
+TEST_F(JsonWriterTest, Doubles_NonFinite_AsNull) {
+	EXPECT_EQ(Element(std::nan("")).to_json(), "null");
+	EXPECT_EQ(Element(HUGE_VAL).to_json(), "null");
+}
+
+TEST_F(JsonWriterTest, String_Escapes) {
+	Element el(std::string("a\x01\x1f\x7f/\"\\\b\f\n\r\t\xC3\xA9"));
+
+	EXPECT_EQ(el.to_json(), "\"a\\u0001\\u001f\x7f/\\\"\\\\\\b\\f\\n\\r\\t\xC3\xA9\"");
+	EXPECT_EQ(el.to_json(), nlohmann::json(el.get_string()).dump());
+}
+
+TEST_F(JsonWriterTest, String_InvalidUtf8_Throws) {
+	EXPECT_THROW(Element(std::string("\xC3")).to_json(), Maze::MazeException);
+	EXPECT_THROW(Element(std::string("\xFF")).to_json(), Maze::MazeException);
+	EXPECT_THROW(Element(std::string("\xED\xA0\x80")).to_json(), Maze::MazeException);
+}
+
+TEST_F(JsonWriterTest, String_LongRuns) {
+	const std::string special[] = { "\"", "\\", "\n", "\x01", "\xC3\xA9", "\xF0\x9F\x98\x80" };
+
+	// Every special character at every offset of the 16 and 32 byte blocks
+	for (const std::string& c : special) {
+		for (size_t offset = 0; offset < 70; ++offset) {
+			std::string value(offset, 'a');
+			value += c + std::string(40, 'b');
+
+			EXPECT_EQ(Element(value).to_json(), nlohmann::json(value).dump()) << offset;
+		}
+	}
+
+	std::string invalid(100, 'a');
+	invalid[67] = '\xC3';
+	try {
+		Element(invalid).to_json();
+		FAIL();
+	}
+	catch (const Maze::MazeException& e) {
+		EXPECT_NE(std::string(e.what()).find("index 67"), std::string::npos);
+	}
+}
+
+TEST_F(JsonWriterTest, String_Utf8MatchesNlohmann) {
+	// Every pair of bytes after multi byte text, on both sides of the 16 and 32 byte block boundaries
+	for (size_t offset : { 16, 31 }) {
+		std::string prefix(offset % 2, 'a');
+		while (prefix.size() < offset)
+			prefix += "\xD0\x96";
+
+		for (int first = 0x80; first < 0x100; ++first) {
+			for (int second = 0x20; second < 0x100; ++second) {
+				for (const char* suffix : { " end", "\x80 end", "\x80\x80 end" }) {
+					std::string value = prefix;
+					value.push_back((char)first);
+					value.push_back((char)second);
+					value += suffix;
+					value += prefix;
+
+					bool valid = true;
+					std::string expected;
+					try {
+						expected = nlohmann::json(value).dump();
+					}
+					catch (const nlohmann::json::exception&) {
+						valid = false;
+					}
+
+					if (valid)
+						EXPECT_EQ(Element(value).to_json(), expected) << offset << " " << first << " " << second;
+					else
+						EXPECT_THROW(Element(value).to_json(), Maze::MazeException) << offset << " " << first << " " << second;
+				}
+			}
+		}
+	}
+}
+
+TEST_F(JsonWriterTest, Function_AsNull) {
+	Element el(Maze::Type::Object);
+	el.set("callback", Element([](const Element& value) { return value; }));
+
+	EXPECT_EQ(el.to_json(-1), R"({"callback":null})");
+}
+
+TEST_F(JsonWriterTest, ParseWrite_RoundTrip) {
+	Element el = Element::from_json(document);
+
+	EXPECT_EQ(Element::from_json(el.to_json(-1)).to_json(), el.to_json());
+}
+
+// Records the size of every write, to check output is produced in bounded chunks
+class ChunkRecorder : public std::streambuf {
+public:
+	std::string output;
+	size_t largest_write = 0;
+
+protected:
+	std::streamsize xsputn(const char* data, std::streamsize size) override {
+		output.append(data, size);
+		largest_write = std::max(largest_write, (size_t)size);
+		return size;
+	}
+
+	int_type overflow(int_type c) override {
+		if (c != traits_type::eof())
+			output.push_back((char)c);
+		return c;
+	}
+};
+
+static Element make_large_element() {
+	Element el(Maze::Type::Array);
+	for (int i = 0; i < 5000; ++i) {
+		el << Element::from_json(document);
+	}
+	el << Element(std::string(300000, 'x'));
+
+	return el;
+}
+
+TEST_F(JsonWriterTest, ToJson_AppendsToString) {
+	std::string output = "prefix ";
+	Element(Maze::Type::Array).to_json(output, -1);
+	Element::from_json(document).to_json(output, 2);
+
+	EXPECT_EQ(output, "prefix []" + Element::from_json(document).to_json(2));
+}
+
+TEST_F(JsonWriterTest, ToJson_Stream_WritesBoundedChunks) {
+	const Element el = make_large_element();
+
+	ChunkRecorder recorder;
+	std::ostream stream(&recorder);
+	el.to_json(stream, -1);
+
+	EXPECT_EQ(recorder.output, el.to_json(-1));
+	EXPECT_LE(recorder.largest_write, 64 * 1024);
+
+	// Deep nesting and escapes are appended past the chunk size between checks
+	Element nested = Element(std::string(100000, '"'));
+	for (int i = 0; i < 100; ++i) {
+		nested = Element(std::vector<Element>{ nested });
+	}
+	ChunkRecorder indented;
+	std::ostream indented_stream(&indented);
+	nested.to_json(indented_stream, 1000);
+
+	EXPECT_EQ(indented.output, nested.to_json(1000));
+	EXPECT_LE(indented.largest_write, 64 * 1024);
+
+	std::ostringstream failed;
+	failed.setstate(std::ios::badbit);
+	EXPECT_THROW(el.to_json(failed), Maze::MazeException);
+}
+
+TEST_F(JsonWriterTest, ToJson_File) {
+	const Element el = make_large_element();
+	const std::string expected = el.to_json(2);
+
+	std::FILE* file = std::tmpfile();
+	ASSERT_NE(file, nullptr);
+	el.to_json(file, 2);
+
+	std::string output(expected.size() + 1, '\0');
+	std::rewind(file);
+	output.resize(std::fread(&output[0], 1, output.size(), file));
+	std::fclose(file);
+
+	EXPECT_EQ(output, expected);
+}
+
+#ifndef _WIN32
+TEST_F(JsonWriterTest, ToJson_FileDescriptor) {
+	const Element el = make_large_element();
+	const std::string expected = el.to_json(-1);
+
+	std::FILE* file = std::tmpfile();
+	ASSERT_NE(file, nullptr);
+	el.to_json_fd(fileno(file), -1);
+
+	std::string output(expected.size() + 1, '\0');
+	std::rewind(file);
+	output.resize(std::fread(&output[0], 1, output.size(), file));
+	std::fclose(file);
+
+	EXPECT_EQ(output, expected);
+	EXPECT_THROW(el.to_json_fd(-1), Maze::MazeException);
+}
+#endif
+
+TEST_F(JsonWriterTest, JsonSize_MatchesOutput) {
+	Element el = Element::from_json(document);
+	el["nested"].set("text", Element(std::string("a\x01\"\\\n\t\xC3\xA9\xF0\x9F\x98\x80 end")));
+	el["nested"].set("doubles", Element::from_json("[1e300, -1.5e-7, 0.001, 123456789012345.0, -0.0, 3.0]"));
+	el.set("callback", Element([](const Element& value) { return value; }));
+
+	for (int indentation : { -1, 0, 2, 4 }) {
+		EXPECT_EQ(el.json_size(indentation), el.to_json(indentation).size()) << indentation;
+		EXPECT_EQ(el.json_size(indentation, true), el.to_json(indentation).size()) << indentation;
+	}
+
+	for (const char* scalar : { "null", "true", "false", "-2147483648", "0.1", "\"\"" }) {
+		EXPECT_EQ(Element::from_json(scalar).json_size(), strlen(scalar));
+	}
+
+	const Element large = make_large_element();
+	EXPECT_EQ(large.json_size(2), large.to_json(2).size());
+
+	EXPECT_THROW(Element(std::string("\xC3")).json_size(), Maze::MazeException);
+}
+
+TEST_F(JsonWriterTest, JsonSize_CacheDroppedOnChange) {
+	Element el = Element::from_json(document);
+	const size_t size = el.json_size(2, true);
+
+	el["nested"]["list"].push_back(Element("added"));
+	EXPECT_NE(el.json_size(2, true), size);
+	EXPECT_EQ(el.json_size(2, true), el.to_json(2).size());
+
+	Element copy = el;
+	copy["version"].remove_all_children();
+	EXPECT_EQ(copy.json_size(-1, true), copy.to_json(-1).size());
+	EXPECT_EQ(el.json_size(-1, true), el.to_json(-1).size());
+}
+
+TEST_F(JsonWriterTest, JsonSize_CacheNoticesHeldReferences) {
+	Element el = Element::from_json(document);
+	Element& nested = el["nested"];
+	Element& name = el["name"];
+
+	el.json_size(2, true);
+
+	name = "a much longer name than before";
+	EXPECT_EQ(el.json_size(2, true), el.to_json(2).size());
+
+	nested.set("added", Element(std::vector<Element>{ Element(1), Element(2.5) }));
+	EXPECT_EQ(el.json_size(2, true), el.to_json(2).size());
+
+	nested["added"][0].set_string("one");
+	EXPECT_EQ(el.json_size(-1, true), el.to_json(-1).size());
+
+	nested["added"][1].get_double_ref() = 12345.0;
+	EXPECT_EQ(el.json_size(-1, true), el.to_json(-1).size());
+
+	Element& added = nested["added"];
+	el.json_size(-1, true);
+	added.remove_all_children();
+	EXPECT_EQ(el.json_size(-1, true), el.to_json(-1).size());
+
+	// Reading the tree again keeps the cache valid
+	const size_t cached = el.json_size(4, true);
+	EXPECT_EQ(el.json_size(4, true), cached);
+	EXPECT_EQ(el.to_json(4).size(), cached);
+}
+
+TEST_F(JsonWriterTest, JsonSize_CacheNoticesValueReferences) {
+	Element el = Element::from_json(document);
+	std::pmr::string& name = el["name"].get_string_ref();
+	int& major = el["version"][0].get_int_ref();
+
+	el.json_size(-1, true);
+	name += " with a longer suffix";
+	major = 1234567;
+
+	EXPECT_EQ(el.json_size(-1, true), el.to_json(-1).size());
+	EXPECT_NE(el.to_json(-1).find("[1234567,2,0]"), std::string::npos);
+}
@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+#include <Maze/Maze.hpp>
+#include <nlohmann/json.hpp>
+#include <climits>
+#include <cmath>
+#include "TestData.hpp"
+
+using Maze::Element;
+using Maze::Tests::sample_json;
+
+class MsgPackTest : public ::testing::Test {};
+
+TEST_F(MsgPackTest, RoundTrip) {
+	Element el = Element::from_json(sample_json);
+	el.set("long_text", Element(std::string(70000, 'x')));
+	el.set("wide", Element(std::vector<Element>(70000, Element(1))));
+
+	Element decoded = Element::from_msgpack(el.to_msgpack());
+
+	EXPECT_EQ(decoded.to_json(-1), el.to_json(-1));
+	EXPECT_TRUE(decoded["ints"][22].is_int());
+	EXPECT_EQ(decoded["ints"][22].i(), INT_MIN);
+}
+
+TEST_F(MsgPackTest, MatchesNlohmann) {
+	const nlohmann::json json = nlohmann::json::parse(sample_json);
+	Element el = Element::from_json(sample_json);
+
+	EXPECT_EQ(nlohmann::json::from_msgpack(el.to_msgpack()), json);
+	EXPECT_EQ(Element::from_msgpack(nlohmann::json::to_msgpack(json)).to_json(-1), json.dump());
+}
+
+TEST_F(MsgPackTest, SmallestEncodings) {
+	EXPECT_EQ(Element(5).to_msgpack(), std::vector<uint8_t>({ 0x05 }));
+	EXPECT_EQ(Element(-3).to_msgpack(), std::vector<uint8_t>({ 0xfd }));
+	EXPECT_EQ(Element(300).to_msgpack(), std::vector<uint8_t>({ 0xcd, 0x01, 0x2c }));
+	EXPECT_EQ(Element(1.5).to_msgpack(), std::vector<uint8_t>({ 0xca, 0x3f, 0xc0, 0x00, 0x00 }));
+	EXPECT_EQ(Element("ab").to_msgpack(), std::vector<uint8_t>({ 0xa2, 'a', 'b' }));
+	EXPECT_EQ(Element().to_msgpack(), std::vector<uint8_t>({ 0xc0 }));
+}
+
+TEST_F(MsgPackTest, DoublesOutsideFloatRange) {
+	EXPECT_EQ(Element(1e300).to_msgpack().size(), 9u);
+	EXPECT_EQ(Element::from_msgpack(Element(-1e300).to_msgpack()).d(), -1e300);
+	EXPECT_EQ(Element(INFINITY).to_msgpack(), std::vector<uint8_t>({ 0xca, 0x7f, 0x80, 0x00, 0x00 }));
+}
+
+TEST_F(MsgPackTest, WideIntegersBecomeDoubles) {
+	Element el = Element::from_msgpack({ 0xcf, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00 });
+	EXPECT_TRUE(el.is_double());
+	EXPECT_EQ(el.d(), 4294967296.0);
+
+	el = Element::from_msgpack({ 0xd3, 0xff, 0xff, 0xff, 0xff, 0x7f, 0xff, 0xff, 0xff });
+	EXPECT_TRUE(el.is_double());
+	EXPECT_EQ(el.d(), -2147483649.0);
+
+	el = Element::from_msgpack({ 0xd1, 0xff, 0x00 });
+	EXPECT_EQ(el.i(), -256);
+}
+
+TEST_F(MsgPackTest, Invalid_Throws) {
+	const std::vector<std::vector<uint8_t>> inputs = {
+		{},
+		{ 0xc1 },
+		{ 0xcd, 0x01 },
+		{ 0xa3, 'a', 'b' },
+		{ 0x92, 0x01 },
+		{ 0x81, 0x01, 0x02 },
+		{ 0xd4, 0x00, 0x00 },
+		{ 0x01, 0x02 },
+		{ 0xdd, 0xff, 0xff, 0xff, 0xff },
+	};
+
+	for (const auto& input : inputs) {
+		EXPECT_THROW(Element::from_msgpack(input), Maze::MazeException);
+	}
+
+	EXPECT_THROW(Element::from_msgpack(std::vector<uint8_t>(5000, 0x91)), Maze::MazeException);
+}
@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+#include <Maze/NdJson.hpp>
+#include <cstdio>
+#include <fstream>
+
+using Maze::Element;
+using Maze::NdJson;
+
+class NdJsonTest : public ::testing::Test {};
+
+static std::string make_lines(int count) {
+	std::string input;
+	for (int i = 0; i < count; ++i) {
+		input += R"({"id":)" + std::to_string(i) + R"(,"name":"item )" + std::to_string(i) + R"(","tags":[1,2,3]})" + "\n";
+	}
+	return input;
+}
+
+TEST_F(NdJsonTest, Parse_Lines) {
+	std::vector<Element> elements = NdJson::parse("{\"a\": 1}\n\n[1, 2]\r\n  \n\"text\"\n42");
+
+	ASSERT_EQ(elements.size(), 4);
+	EXPECT_EQ(elements[0]["a"].i(), 1);
+	EXPECT_EQ(elements[1].count_children(), 2);
+	EXPECT_EQ(elements[2].s(), "text");
+	EXPECT_EQ(elements[3].i(), 42);
+
+	EXPECT_TRUE(NdJson::parse("").empty());
+	EXPECT_TRUE(NdJson::parse("\n \n").empty());
+}
+
+TEST_F(NdJsonTest, Parse_KeepsOrderAcrossThreads) {
+	const std::string input = make_lines(20000);
+
+	for (unsigned int threads : { 1u, 3u, 8u }) {
+		std::vector<Element> elements = NdJson::parse(input, threads);
+
+		ASSERT_EQ(elements.size(), 20000);
+		for (int i = 0; i < 20000; ++i) {
+			ASSERT_EQ(elements[i]["id"].i(), i);
+		}
+	}
+}
+
+TEST_F(NdJsonTest, Parse_ReportsLineOfError) {
+	std::string input = make_lines(10000);
+	input.replace(input.find(R"({"id":7000,)"), 1, "x");
+
+	try {
+		NdJson::parse(input, 4);
+		FAIL() << "Expected MazeException";
+	}
+	catch (const Maze::MazeException& e) {
+		EXPECT_NE(std::string(e.what()).find("on line 7001"), std::string::npos) << e.what();
+	}
+}
+
+TEST_F(NdJsonTest, Write_RoundTrip) {
+	const std::string input = make_lines(5000);
+
+	EXPECT_EQ(NdJson::write(NdJson::parse(input), 4), input);
+	EXPECT_EQ(NdJson::write({}), "");
+	EXPECT_EQ(NdJson::write({ Element(1), Element("a") }, 1), "1\n\"a\"\n");
+}
+
+TEST_F(NdJsonTest, ParseFile) {
+	const std::string path = ::testing::TempDir() + "maze_ndjson_file.jsonl";
+	{
+		std::ofstream file(path, std::ios::binary);
+		file << make_lines(3);
+	}
+
+	std::vector<Element> elements = NdJson::parse_file(path);
+	std::remove(path.c_str());
+
+	ASSERT_EQ(elements.size(), 3);
+	EXPECT_EQ(elements[2]["name"].s(), "item 2");
+}
@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+#include <Maze/Snapshot.hpp>
+#include <climits>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include "TestData.hpp"
+
+using Maze::Element;
+using Maze::Tests::sample_json;
+using Maze::Snapshot;
+using Maze::SnapshotView;
+
+class SnapshotTest : public ::testing::Test {};
+
+TEST_F(SnapshotTest, ReadInPlace) {
+	const Snapshot snapshot(Snapshot::write(Element::from_json(sample_json)));
+	const SnapshotView root = snapshot.root();
+
+	EXPECT_TRUE(root.is_object());
+	EXPECT_EQ(root.count_children(), 13);
+	EXPECT_EQ(root["name"].get_string(), "maze");
+	EXPECT_EQ(root["version"][1].get_int(), 2);
+	EXPECT_EQ(root["ratio"].get_double(), 0.1);
+	EXPECT_TRUE(root["enabled"].get_bool());
+	EXPECT_TRUE(root["nothing"].is_null());
+	EXPECT_EQ(root["ints"][22].get_int(), INT_MIN);
+	EXPECT_EQ(root["nested"]["list"][0]["a"][1][1][0].get_int(), 3);
+	EXPECT_EQ(root["alpha"].get_int(), 2);
+	EXPECT_EQ(root["alpha"].get_key(), "alpha");
+}
+
+TEST_F(SnapshotTest, MissingValues) {
+	const Snapshot snapshot(Snapshot::write(Element::from_json(sample_json)));
+	const SnapshotView root = snapshot.root();
+
+	EXPECT_TRUE(root["missing"].is_null());
+	EXPECT_FALSE(root.exists("missing"));
+	EXPECT_TRUE(root.exists("nothing"));
+	EXPECT_TRUE(root["version"][3].is_null());
+	EXPECT_TRUE(root["name"]["x"][0].is_null());
+	EXPECT_EQ(root["name"].get_int(5), 5);
+	EXPECT_EQ(root["version"].get_string("none"), "none");
+	EXPECT_EQ(root["empty_object"].count_children(), 0);
+}
+
+TEST_F(SnapshotTest, IterationKeepsOrder) {
+	const Snapshot snapshot(Snapshot::write(Element::from_json(sample_json)));
+
+	std::string keys;
+	for (const SnapshotView& child : snapshot.root()) {
+		keys += std::string(child.get_key()) + ",";
+	}
+	EXPECT_EQ(keys, "name,version,ratio,half,enabled,nothing,ints,empty_array,empty_object,nested,zeta,alpha,mid,");
+
+	int sum = 0;
+	for (const SnapshotView& child : snapshot.root()["version"]) {
+		sum += child.get_int();
+	}
+	EXPECT_EQ(sum, 3);
+}
+
+TEST_F(SnapshotTest, ToElement_RoundTrip) {
+	const Element el = Element::from_json(sample_json);
+	const Snapshot snapshot(Snapshot::write(el));
+
+	EXPECT_EQ(snapshot.root().to_element().to_json(-1), el.to_json(-1));
+	EXPECT_EQ(Snapshot(Snapshot::write(Element(42))).root().get_int(), 42);
+}
+
+TEST_F(SnapshotTest, WideObjectLookup) {
+	Element el(Maze::Type::Object);
+	for (int i = 0; i < 1000; ++i) {
+		el.set("key_" + std::to_string(i), Element(i));
+	}
+
+	const Snapshot snapshot(Snapshot::write(el));
+	for (int i = 0; i < 1000; ++i) {
+		ASSERT_EQ(snapshot.root()["key_" + std::to_string(i)].get_int(-1), i);
+	}
+}
+
+TEST_F(SnapshotTest, OpenFile) {
+	const std::string path = ::testing::TempDir() + "maze_snapshot_file.bin";
+	Snapshot::write_file(Element::from_json(sample_json), path);
+
+	{
+		const Snapshot snapshot = Snapshot::open_file(path);
+		EXPECT_EQ(snapshot.root()["nested"]["list"][3].get_int(), -7);
+	}
+
+	std::remove(path.c_str());
+	EXPECT_THROW(Snapshot::open_file(path), Maze::MazeException);
+}
+
+TEST_F(SnapshotTest, Invalid_Throws) {
+	std::vector<uint8_t> data = Snapshot::write(Element::from_json(sample_json));
+
+	EXPECT_THROW(Snapshot(std::vector<uint8_t>(data.begin(), data.begin() + 16)), Maze::MazeException);
+	EXPECT_THROW(Snapshot(std::vector<uint8_t>(64, 0)), Maze::MazeException);
+
+	std::vector<uint8_t> wrong_version = data;
+	wrong_version[8] = 9;
+	EXPECT_THROW(Snapshot(std::move(wrong_version)), Maze::MazeException);
+
+	// Root slot pointing past the end
+	std::vector<uint8_t> corrupt = data;
+	corrupt[16 + 15] = 0x7f;
+	const Snapshot snapshot(std::move(corrupt));
+	EXPECT_THROW(snapshot.root()["name"], Maze::MazeException);
+}
+
+TEST_F(SnapshotTest, CyclicOffsets_Throws) {
+	std::vector<uint8_t> data = Snapshot::write(Element::from_json("[[]]"));
+
+	// Make the inner array point at its own slot
+	uint64_t block;
+	std::memcpy(&block, data.data() + 16 + 8, sizeof(block));
+	const uint32_t count = 1;
+	std::memcpy(data.data() + block + 4, &count, sizeof(count));
+	std::memcpy(data.data() + block + 8, &block, sizeof(block));
+
+	const Snapshot snapshot(std::move(data));
+	EXPECT_EQ(snapshot.root()[0][0][0].count_children(), 1u);
+	EXPECT_THROW(snapshot.root().to_element(), Maze::MazeException);
+}
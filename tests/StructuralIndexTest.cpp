@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+#include <Maze/StructuralIndex.hpp>
+#include <random>
+#include <string>
+
+using Maze::StructuralIndex;
+
+class StructuralIndexTest : public ::testing::Test {};
+
+static std::vector<uint32_t> scan(const std::string& input, StructuralIndex::Implementation implementation, size_t chunk_size = 0) {
+	StructuralIndex index(implementation);
+	std::vector<uint32_t> positions;
+
+	if (chunk_size == 0)
+		chunk_size = input.size();
+
+	for (size_t offset = 0; offset < input.size(); offset += chunk_size) {
+		const uint32_t size = (uint32_t)std::min(chunk_size, input.size() - offset);
+		std::vector<uint32_t> chunk_positions;
+		index.scan(input.data() + offset, size, chunk_positions);
+
+		for (uint32_t position : chunk_positions)
+			positions.push_back((uint32_t)offset + position);
+	}
+
+	return positions;
+}
+
+static std::vector<StructuralIndex::Implementation> supported_implementations() {
+	std::vector<StructuralIndex::Implementation> implementations;
+
+	for (auto implementation : { StructuralIndex::Implementation::Scalar, StructuralIndex::Implementation::Sse2, StructuralIndex::Implementation::Avx2 }) {
+		if (StructuralIndex::is_supported(implementation))
+			implementations.push_back(implementation);
+	}
+
+	return implementations;
+}
+
+TEST_F(StructuralIndexTest, Scan_FindsStructuralCharacters) {
+	const std::string input = R"({"a": [1, "x,]"], "b\"": {}})";
+
+	for (auto implementation : supported_implementations()) {
+		const std::vector<uint32_t> positions = scan(input, implementation);
+
+		const std::vector<uint32_t> expected = { 0, 1, 4, 6, 8, 10, 15, 16, 18, 23, 25, 26, 27 };
+		EXPECT_EQ(positions, expected);
+	}
+}
+
+TEST_F(StructuralIndexTest, Scan_BackslashRuns) {
+	for (auto implementation : supported_implementations()) {
+		StructuralIndex index(implementation);
+		std::vector<uint32_t> positions;
+
+		// Even runs leave the closing quote unescaped
+		index.scan(R"(["\\\\",1])", 10, positions);
+		EXPECT_EQ(positions, std::vector<uint32_t>({ 0, 1, 7, 9 }));
+		EXPECT_FALSE(index.in_string());
+
+		index.reset();
+		positions.clear();
+		index.scan(R"(["\\\",1])", 9, positions);
+		EXPECT_EQ(positions, std::vector<uint32_t>({ 0, 1 }));
+		EXPECT_TRUE(index.in_string());
+	}
+}
+
+TEST_F(StructuralIndexTest, Scan_MatchesScalarAcrossBlocks) {
+	const char alphabet[] = { '"', '\\', '{', '}', '[', ']', ':', ',', 'a', ' ', '\\', '"' };
+	std::mt19937 random(42);
+
+	for (int round = 0; round < 200; ++round) {
+		std::string input(random() % 600, ' ');
+		for (char& c : input)
+			c = alphabet[random() % sizeof(alphabet)];
+
+		const std::vector<uint32_t> expected = scan(input, StructuralIndex::Implementation::Scalar);
+
+		for (auto implementation : supported_implementations()) {
+			ASSERT_EQ(scan(input, implementation), expected);
+			ASSERT_EQ(scan(input, implementation, StructuralIndex::block_size), expected);
+			ASSERT_EQ(scan(input, implementation, StructuralIndex::block_size * 3), expected);
+		}
+	}
+}
+
+TEST_F(StructuralIndexTest, BestImplementation_IsSupported) {
+	EXPECT_TRUE(StructuralIndex::is_supported(StructuralIndex::best_implementation()));
+	EXPECT_TRUE(StructuralIndex::is_supported(StructuralIndex::Implementation::Scalar));
+}
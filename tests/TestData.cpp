@@ -0,0 +1,11 @@
+#include "TestData.hpp"
+
+namespace Maze::Tests {
+
+	const char* const sample_json = R"({"name":"maze","version":[1,2,0],"ratio":0.1,"half":0.5,"enabled":true,"nothing":null,)"
+		R"("ints":[0,23,24,127,128,255,256,65535,65536,2147483647,-1,-24,-25,-32,-33,-128,-129,-256,-257,)"
+		R"(-32768,-32769,-65537,-2147483648],)"
+		R"("empty_array":[],"empty_object":{},"nested":{"list":[{"a":[1,[2,[3]]]},[],"",-7]},)"
+		R"("zeta":1,"alpha":2,"mid":3})";
+
+}  // namespace Maze::Tests
@@ -0,0 +1,9 @@
+#pragma once
+
+namespace Maze::Tests {
+
+	// Object covering every value type, integers on both sides of the CBOR and
+	// MessagePack size boundaries, nested and empty containers and unsorted keys.
+	extern const char* const sample_json;
+
+}  // namespace Maze::Tests
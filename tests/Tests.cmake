@@ -7,13 +7,27 @@ set(MAZE_TESTS_SOURCES
     Element/DoubleTest.cpp
     Element/FunctionTest.cpp
     Element/IntegerTest.cpp
+    Element/MoveTest.cpp
     Element/NullTest.cpp
     Element/ObjectTest.cpp
+    Element/StorageTest.cpp
     Element/StringTest.cpp
 
     TypeTest.cpp
+    CborTest.cpp
+    DocumentTest.cpp
     HelpersTest.cpp
+    JsonParserTest.cpp
+    JsonPushParserTest.cpp
+    JsonSegmentsTest.cpp
+    JsonStreamTest.cpp
+    JsonWriterTest.cpp
     MazeExceptionTest.cpp
+    MsgPackTest.cpp
+    NdJsonTest.cpp
+    SnapshotTest.cpp
+    StructuralIndexTest.cpp
+    TestData.cpp
     VersionTest.cpp
 
     main.cpp